@@ -0,0 +1,196 @@
+/*
+ * Heap allocation counters and peak RSS shared by both problems
+ * =============================================================
+ *
+ * Compile with -DALLOC_STATS to replace the global operator new / delete
+ * with versions that count allocations and requested bytes (relaxed
+ * atomics, so the worker threads are counted too). alloc_snapshot() reads
+ * the counters; the difference of two snapshots is the heap traffic of the
+ * code in between. Without the flag the standard allocator is left alone
+ * and the snapshots are 0; benchmarks check `alloc_counting` and leave the
+ * allocation columns empty.
+ *
+ * peak_rss_bytes() is the process's high-water resident set size.
+ * reset_peak_rss() restarts it from the current size where the OS allows
+ * (Linux: /proc/self/clear_refs), so it can be measured per trial.
+ *
+ * Peak RSS needs no flag. The replacement allocation functions must be
+ * defined once per program: include this header from exactly one
+ * translation unit (both programs are single files).
+ */
+
+#ifndef ALLOC_STATS_H
+#define ALLOC_STATS_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#include <malloc.h>
+#else
+#include <sys/resource.h>
+#endif
+
+struct AllocStats {
+    long long allocations;
+    long long bytes;
+};
+
+#ifdef ALLOC_STATS
+
+const bool alloc_counting = true;
+
+inline std::atomic<long long>& alloc_counter() {
+    static std::atomic<long long> count(0);
+    return count;
+}
+
+inline std::atomic<long long>& alloc_byte_counter() {
+    static std::atomic<long long> bytes(0);
+    return bytes;
+}
+
+inline AllocStats alloc_snapshot() {
+    return {alloc_counter().load(std::memory_order_relaxed),
+            alloc_byte_counter().load(std::memory_order_relaxed)};
+}
+
+#else
+
+const bool alloc_counting = false;
+
+inline AllocStats alloc_snapshot() { return {0, 0}; }
+
+#endif
+
+// Allocations and bytes since `before`
+inline AllocStats alloc_since(const AllocStats& before) {
+    AllocStats now = alloc_snapshot();
+    return {now.allocations - before.allocations, now.bytes - before.bytes};
+}
+
+inline uint64_t peak_rss_bytes() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.PeakWorkingSetSize;
+    }
+    return 0;
+#else
+    // VmHWM follows clear_refs resets; ru_maxrss does not on every kernel
+    if (FILE* status = std::fopen("/proc/self/status", "r")) {
+        char line[256];
+        unsigned long long kb = 0;
+        bool found = false;
+        while (!found && std::fgets(line, sizeof(line), status)) {
+            found = std::sscanf(line, "VmHWM: %llu kB", &kb) == 1;
+        }
+        std::fclose(status);
+        if (found) return kb * 1024;
+    }
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss;
+#else
+    return (uint64_t)usage.ru_maxrss * 1024;
+#endif
+#endif
+}
+
+// False when the peak cannot be reset (it then keeps the process maximum)
+inline bool reset_peak_rss() {
+#if defined(__linux__)
+    FILE* refs = std::fopen("/proc/self/clear_refs", "w");
+    if (!refs) return false;
+    bool ok = std::fputs("5", refs) >= 0;
+    return std::fclose(refs) == 0 && ok;
+#else
+    return false;
+#endif
+}
+
+#ifdef ALLOC_STATS
+
+// --- Counting replacements of the global allocation functions ---
+
+inline void* counted_alloc(std::size_t size) {
+    alloc_counter().fetch_add(1, std::memory_order_relaxed);
+    alloc_byte_counter().fetch_add(size, std::memory_order_relaxed);
+    void* p = std::malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+inline void* counted_aligned_alloc(std::size_t size, std::size_t alignment) {
+    alloc_counter().fetch_add(1, std::memory_order_relaxed);
+    alloc_byte_counter().fetch_add(size, std::memory_order_relaxed);
+#ifdef _WIN32
+    void* p = _aligned_malloc(size ? size : 1, alignment);
+#else
+    void* p = nullptr;
+    if (posix_memalign(&p, alignment < sizeof(void*) ? sizeof(void*) : alignment, size ? size : 1) != 0) {
+        p = nullptr;
+    }
+#endif
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+inline void counted_aligned_free(void* p) {
+#ifdef _WIN32
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+}
+
+void* operator new(std::size_t size) { return counted_alloc(size); }
+void* operator new[](std::size_t size) { return counted_alloc(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return counted_aligned_alloc(size, (std::size_t)alignment);
+}
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return counted_aligned_alloc(size, (std::size_t)alignment);
+}
+void operator delete(void* p, std::align_val_t) noexcept { counted_aligned_free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { counted_aligned_free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { counted_aligned_free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { counted_aligned_free(p); }
+
+// The nothrow forms (std::stable_sort's buffer uses them) must be replaced
+// as well, or they would pair the library's allocator with our free().
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try { return counted_alloc(size); } catch (...) { return nullptr; }
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    try { return counted_alloc(size); } catch (...) { return nullptr; }
+}
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    try { return counted_aligned_alloc(size, (std::size_t)alignment); } catch (...) { return nullptr; }
+}
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    try { return counted_aligned_alloc(size, (std::size_t)alignment); } catch (...) { return nullptr; }
+}
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { counted_aligned_free(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { counted_aligned_free(p); }
+
+#endif
+
+#endif
@@ -0,0 +1,200 @@
+/*
+ * Work-stealing batch runner shared by both problems
+ * ==================================================
+ *
+ * Solves a stream of independent jobs (one instance file each) on a fixed
+ * set of worker threads and writes one result line per job, in submission
+ * order, as soon as every earlier job is done.
+ *
+ * submit() deals jobs round-robin onto per-worker deques. A worker takes
+ * the oldest job of its own deque and, when that is empty, steals the
+ * newest job of another worker's, so a few slow instances do not leave
+ * the other cores idle. Each deque has its own lock; jobs are whole
+ * instances (milliseconds each), so the locks are not contended.
+ *
+ * No job more than max_ahead places past the oldest unwritten result is
+ * started, so a slow job holds back at most max_ahead finished results.
+ *
+ * The solve function gets the worker id, so callers can keep per-worker
+ * state (reusable solver objects, buffers) in a vector indexed by it.
+ */
+
+#ifndef BATCH_POOL_H
+#define BATCH_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+class BatchPool {
+public:
+    // Returns the result line (without newline) of one job
+    typedef std::function<std::string(int worker, const std::string& job)> Solve;
+
+private:
+    struct WorkerQueue {
+        std::mutex mtx;
+        std::deque<std::pair<size_t, std::string>> jobs;    // (index, job)
+    };
+
+    Solve solve;
+    std::ostream& out;
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> workers;
+
+    std::mutex wait_mtx;
+    std::condition_variable work_cv;
+    std::atomic<long long> queued;      // Submitted and not yet taken
+    bool closed;
+    size_t submitted;
+    long long progress;                 // Bumped by submits and writes (under wait_mtx)
+    std::atomic<long long> stolen;
+    size_t max_ahead;
+
+    // Finished results waiting for an earlier one
+    std::mutex emit_mtx;
+    std::map<size_t, std::string> finished;
+    std::atomic<size_t> next_emit;
+
+    // Pop the front or back of q if that job is inside the window
+    bool pop_within(WorkerQueue& q, bool front, std::pair<size_t, std::string>& job) {
+        if (q.jobs.empty()) return false;
+        size_t limit = next_emit.load() + max_ahead;
+        std::pair<size_t, std::string>& end = front ? q.jobs.front() : q.jobs.back();
+        if (end.first >= limit) return false;
+        job = std::move(end);
+        if (front) {
+            q.jobs.pop_front();
+        } else {
+            q.jobs.pop_back();
+        }
+        return true;
+    }
+
+    // A deque holds increasing indices, so its front is the oldest job and
+    // the unwritten job next_emit, while queued, is the front of its deque:
+    // a thief falls back to the front when the back is out of the window,
+    // so that job can always be taken.
+    bool take(int id, std::pair<size_t, std::string>& job) {
+        int count = queues.size();
+        {
+            WorkerQueue& own = *queues[id];
+            std::lock_guard<std::mutex> lock(own.mtx);
+            if (pop_within(own, true, job)) return true;
+        }
+        for (int k = 1; k < count; k++) {
+            WorkerQueue& victim = *queues[(id + k) % count];
+            std::lock_guard<std::mutex> lock(victim.mtx);
+            if (pop_within(victim, false, job) || pop_within(victim, true, job)) {
+                stolen++;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void emit(size_t index, std::string result) {
+        bool advanced = false;
+        {
+            std::lock_guard<std::mutex> lock(emit_mtx);
+            finished.emplace(index, std::move(result));
+            for (auto it = finished.begin(); it != finished.end() && it->first == next_emit;
+                 it = finished.erase(it)) {
+                out << it->second << '\n';
+                next_emit++;
+                advanced = true;
+            }
+        }
+        if (advanced) {
+            {
+                std::lock_guard<std::mutex> lock(wait_mtx);
+                progress++;
+            }
+            work_cv.notify_all();
+        }
+    }
+
+    void worker_loop(int id) {
+        std::pair<size_t, std::string> job;
+        while (true) {
+            long long seen;
+            {
+                std::lock_guard<std::mutex> lock(wait_mtx);
+                seen = progress;
+            }
+            if (take(id, job)) {
+                queued--;
+                emit(job.first, solve(id, job.second));
+                continue;
+            }
+            // Nothing (in the window) to take: wait for a submit or a write
+            std::unique_lock<std::mutex> lock(wait_mtx);
+            work_cv.wait(lock, [&] { return (closed && queued == 0) || progress != seen; });
+            if (closed && queued == 0) return;
+        }
+    }
+
+public:
+    // max_ahead = 0 allows 4 jobs per thread past the oldest unwritten one
+    BatchPool(int threads, Solve solve, std::ostream& out, size_t max_ahead = 0)
+        : solve(solve), out(out), queued(0), closed(false), submitted(0), progress(0), stolen(0),
+          max_ahead(max_ahead), next_emit(0) {
+        if (threads < 1) threads = 1;
+        if (this->max_ahead == 0) this->max_ahead = 4 * (size_t)threads;
+        for (int id = 0; id < threads; id++) queues.emplace_back(new WorkerQueue());
+        for (int id = 0; id < threads; id++) workers.emplace_back(&BatchPool::worker_loop, this, id);
+    }
+
+    ~BatchPool() { finish(); }
+
+    BatchPool(const BatchPool&) = delete;
+    BatchPool& operator=(const BatchPool&) = delete;
+
+    // Queue one job (from one thread only)
+    void submit(const std::string& job) {
+        size_t index = submitted++;
+        {
+            WorkerQueue& target = *queues[index % queues.size()];
+            std::lock_guard<std::mutex> lock(target.mtx);
+            target.jobs.emplace_back(index, job);
+        }
+        {
+            std::lock_guard<std::mutex> lock(wait_mtx);
+            queued++;
+            progress++;
+        }
+        work_cv.notify_all();
+    }
+
+    // No more jobs: wait until every result has been written. Returns the
+    // number of jobs.
+    size_t finish() {
+        {
+            std::lock_guard<std::mutex> lock(wait_mtx);
+            if (closed && workers.empty()) return submitted;
+            closed = true;
+        }
+        work_cv.notify_all();
+        for (auto& w : workers) w.join();
+        workers.clear();
+        out.flush();
+        return submitted;
+    }
+
+    int size() const { return queues.size(); }
+
+    // Jobs run by a worker other than the one they were dealt to
+    long long steals() const { return stolen; }
+};
+
+#endif
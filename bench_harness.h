@@ -0,0 +1,385 @@
+/*
+ * Reproducible benchmark suite shared by both problems
+ * ====================================================
+ *
+ * A BenchSuite holds named cases. Every case is run `warmup` times
+ * untimed and then `repetitions` times; repetition r draws its instance
+ * from an mt19937 seeded with hash(suite seed, case name, r), so a case
+ * gives the same instances regardless of which other cases run.
+ *
+ * Inside a case, BenchRun::time(stage, fn) times one stage with
+ * steady_clock (e.g. generate, build, solve, extract) and check(name, v)
+ * records an output value (flow value, number of stops) that must not
+ * change between runs. Per stage the suite reports the median, p95, p99,
+ * mean and a distribution-free 95% confidence interval of the median
+ * (order statistics n/2 -/+ 0.98 sqrt(n)).
+ *
+ * Results are saved as a JSON baseline. compare() re-reads one and flags
+ * a stage as a regression when its median is more than `threshold`
+ * slower and the two confidence intervals do not overlap. With the same
+ * seed and repetitions it also flags any changed check value.
+ */
+
+#ifndef BENCH_HARNESS_H
+#define BENCH_HARNESS_H
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+struct StageStats {
+    std::string stage;
+    int samples;
+    double median, p95, p99, mean, ci_low, ci_high;
+};
+
+struct CaseResult {
+    std::string name;
+    std::vector<StageStats> stages;
+    std::vector<std::pair<std::string, double>> checks;
+};
+
+// Handed to a case body once per repetition
+class BenchRun {
+private:
+    std::vector<std::pair<std::string, double>> stage_ms;
+    std::vector<std::pair<std::string, double>> check_values;
+
+    friend class BenchSuite;
+
+public:
+    std::mt19937 rng;
+
+    explicit BenchRun(uint32_t seed) : rng(seed) {}
+
+    // Run fn() as one timed stage; returns its time in ms
+    template <typename Fn>
+    double time(const std::string& stage, Fn fn) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        auto end = std::chrono::steady_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(end - start).count();
+        for (auto& entry : stage_ms) {
+            if (entry.first == stage) {
+                entry.second += ms;
+                return ms;
+            }
+        }
+        stage_ms.push_back({stage, ms});
+        return ms;
+    }
+
+    void check(const std::string& name, double value) {
+        check_values.push_back({name, value});
+    }
+};
+
+class BenchSuite {
+public:
+    typedef std::function<void(BenchRun&)> CaseBody;
+
+private:
+    std::string program;
+    uint32_t seed;
+    int warmup, repetitions;
+    std::vector<std::pair<std::string, CaseBody>> cases;
+    std::vector<CaseResult> results;
+
+    // FNV-1a over the case name, mixed with the suite seed and repetition
+    uint32_t case_seed(const std::string& name, int repetition) const {
+        uint64_t h = 1469598103934665603ULL ^ seed;
+        for (char c : name) {
+            h ^= (unsigned char)c;
+            h *= 1099511628211ULL;
+        }
+        h ^= (uint64_t)(repetition + 1) * 0x9E3779B97F4A7C15ULL;
+        return (uint32_t)(h ^ (h >> 32));
+    }
+
+    static StageStats summarize(const std::string& stage, std::vector<double> samples) {
+        std::sort(samples.begin(), samples.end());
+        int n = samples.size();
+        auto rank = [&](double q) {    // Nearest rank, 1-based -> index
+            int r = (int)std::ceil(q * n);
+            return samples[std::max(1, std::min(n, r)) - 1];
+        };
+        StageStats s;
+        s.stage = stage;
+        s.samples = n;
+        s.median = n % 2 ? samples[n / 2] : (samples[n / 2 - 1] + samples[n / 2]) / 2;
+        s.p95 = rank(0.95);
+        s.p99 = rank(0.99);
+        double sum = 0;
+        for (double v : samples) sum += v;
+        s.mean = sum / n;
+        int lo = (int)std::floor(n / 2.0 - 0.98 * std::sqrt((double)n));
+        int hi = (int)std::ceil(n / 2.0 + 0.98 * std::sqrt((double)n));
+        s.ci_low = samples[std::max(1, lo) - 1];
+        s.ci_high = samples[std::min(n, hi) - 1];
+        return s;
+    }
+
+    // --- Minimal JSON reader for the files written by write_json() ---
+
+    struct Json {
+        enum Type { NONE, NUMBER, STRING, ARRAY, OBJECT } type = NONE;
+        double number = 0;
+        std::string text;
+        std::vector<Json> items;
+        std::vector<std::pair<std::string, Json>> fields;
+
+        const Json* get(const std::string& key) const {
+            for (auto& f : fields) {
+                if (f.first == key) return &f.second;
+            }
+            return nullptr;
+        }
+    };
+
+    static void skip_space(const std::string& s, size_t& p) {
+        while (p < s.size() && std::isspace((unsigned char)s[p])) p++;
+    }
+
+    static bool parse_string(const std::string& s, size_t& p, std::string& out) {
+        if (p >= s.size() || s[p] != '"') return false;
+        for (p++; p < s.size() && s[p] != '"'; p++) {
+            if (s[p] == '\\' && p + 1 < s.size()) p++;
+            out += s[p];
+        }
+        if (p >= s.size()) return false;
+        p++;
+        return true;
+    }
+
+    static bool parse_json(const std::string& s, size_t& p, Json& out) {
+        skip_space(s, p);
+        if (p >= s.size()) return false;
+        if (s[p] == '{' || s[p] == '[') {
+            bool object = s[p] == '{';
+            char close = object ? '}' : ']';
+            out.type = object ? Json::OBJECT : Json::ARRAY;
+            p++;
+            skip_space(s, p);
+            if (p < s.size() && s[p] == close) {
+                p++;
+                return true;
+            }
+            while (true) {
+                std::string key;
+                if (object) {
+                    skip_space(s, p);
+                    if (!parse_string(s, p, key)) return false;
+                    skip_space(s, p);
+                    if (p >= s.size() || s[p++] != ':') return false;
+                }
+                Json value;
+                if (!parse_json(s, p, value)) return false;
+                if (object) {
+                    out.fields.push_back({key, value});
+                } else {
+                    out.items.push_back(value);
+                }
+                skip_space(s, p);
+                if (p < s.size() && s[p] == ',') {
+                    p++;
+                    continue;
+                }
+                if (p < s.size() && s[p] == close) {
+                    p++;
+                    return true;
+                }
+                return false;
+            }
+        }
+        if (s[p] == '"') {
+            out.type = Json::STRING;
+            return parse_string(s, p, out.text);
+        }
+        const char* begin = s.c_str() + p;
+        char* end;
+        out.number = std::strtod(begin, &end);
+        if (end == begin) return false;
+        out.type = Json::NUMBER;
+        p += end - begin;
+        return true;
+    }
+
+    static double number_of(const Json* value) {
+        return value && value->type == Json::NUMBER ? value->number : NAN;
+    }
+
+public:
+    BenchSuite(const std::string& program, uint32_t seed, int warmup, int repetitions)
+        : program(program), seed(seed), warmup(warmup), repetitions(std::max(1, repetitions)) {}
+
+    void add(const std::string& name, CaseBody body) {
+        cases.push_back({name, body});
+    }
+
+    // Run every case whose name contains `filter` (all when empty)
+    const std::vector<CaseResult>& run(const std::string& filter = "") {
+        results.clear();
+        for (auto& c : cases) {
+            if (!filter.empty() && c.first.find(filter) == std::string::npos) continue;
+            std::cout << "Running " << c.first << " (" << warmup << " warmup + "
+                      << repetitions << " runs)..." << std::endl;
+
+            for (int w = 0; w < warmup; w++) {
+                BenchRun run(case_seed(c.first, w));
+                c.second(run);
+            }
+
+            CaseResult result;
+            result.name = c.first;
+            std::vector<std::string> stage_order;
+            std::vector<std::vector<double>> samples;
+            for (int r = 0; r < repetitions; r++) {
+                BenchRun run(case_seed(c.first, r));
+                c.second(run);
+                for (auto& entry : run.stage_ms) {
+                    size_t k = std::find(stage_order.begin(), stage_order.end(), entry.first) -
+                               stage_order.begin();
+                    if (k == stage_order.size()) {
+                        stage_order.push_back(entry.first);
+                        samples.push_back(std::vector<double>());
+                    }
+                    samples[k].push_back(entry.second);
+                }
+                // Check values: summed over repetitions (fixed seeds make them repeatable)
+                for (auto& entry : run.check_values) {
+                    bool found = false;
+                    for (auto& existing : result.checks) {
+                        if (existing.first == entry.first) {
+                            existing.second += entry.second;
+                            found = true;
+                        }
+                    }
+                    if (!found) result.checks.push_back(entry);
+                }
+            }
+            for (size_t k = 0; k < stage_order.size(); k++) {
+                result.stages.push_back(summarize(stage_order[k], samples[k]));
+            }
+            results.push_back(result);
+
+            for (auto& s : result.stages) {
+                std::printf("  %-10s median %10.3f ms  p95 %10.3f  p99 %10.3f  95%% CI [%.3f, %.3f]\n",
+                            s.stage.c_str(), s.median, s.p95, s.p99, s.ci_low, s.ci_high);
+            }
+        }
+        return results;
+    }
+
+    bool write_json(const std::string& path) const {
+        std::ofstream out(path);
+        if (!out) return false;
+        out.precision(10);
+        out << "{\n  \"program\": \"" << program << "\",\n  \"format\": 1,\n"
+            << "  \"seed\": " << seed << ",\n  \"warmup\": " << warmup
+            << ",\n  \"repetitions\": " << repetitions << ",\n  \"cases\": [";
+        for (size_t c = 0; c < results.size(); c++) {
+            const CaseResult& r = results[c];
+            out << (c ? "," : "") << "\n    {\"name\": \"" << r.name << "\", \"stages\": {";
+            for (size_t k = 0; k < r.stages.size(); k++) {
+                const StageStats& s = r.stages[k];
+                out << (k ? "," : "") << "\n      \"" << s.stage << "\": {\"samples\": " << s.samples
+                    << ", \"median\": " << s.median << ", \"p95\": " << s.p95
+                    << ", \"p99\": " << s.p99 << ", \"mean\": " << s.mean
+                    << ", \"ci_low\": " << s.ci_low << ", \"ci_high\": " << s.ci_high << "}";
+            }
+            out << "},\n      \"checks\": {";
+            for (size_t k = 0; k < r.checks.size(); k++) {
+                out << (k ? ", " : "") << "\"" << r.checks[k].first << "\": " << r.checks[k].second;
+            }
+            out << "}}";
+        }
+        out << "\n  ]\n}\n";
+        return (bool)out;
+    }
+
+    // Compare the last run() against a baseline file. Prints one line per
+    // stage and returns the number of regressions and changed checks, or
+    // -1 if the baseline cannot be read.
+    int compare(const std::string& baseline_path, double threshold) const {
+        std::ifstream in(baseline_path);
+        std::stringstream buffer;
+        buffer << in.rdbuf();
+        std::string text = buffer.str();
+        Json baseline;
+        size_t p = 0;
+        if (!in || !parse_json(text, p, baseline) || !baseline.get("cases")) {
+            std::cerr << "Error: cannot read baseline " << baseline_path << std::endl;
+            return -1;
+        }
+        // Check values are sums over the repetitions' instances
+        bool same_instances = number_of(baseline.get("seed")) == seed &&
+                              number_of(baseline.get("repetitions")) == repetitions;
+        if (!same_instances) {
+            std::cout << "Note: baseline seed or repetitions differ, so the instances differ"
+                         " and check values are not compared\n";
+        }
+
+        int problems = 0;
+        std::printf("\n%-36s %-10s %12s %12s %8s  %s\n", "case", "stage", "baseline_ms",
+                    "current_ms", "ratio", "verdict");
+        for (const CaseResult& r : results) {
+            const Json* old_case = nullptr;
+            for (const Json& c : baseline.get("cases")->items) {
+                const Json* name = c.get("name");
+                if (name && name->text == r.name) old_case = &c;
+            }
+            if (!old_case) {
+                std::printf("%-36s %-10s %12s %12s %8s  %s\n", r.name.c_str(), "-", "-", "-", "-",
+                            "new case");
+                continue;
+            }
+            const Json* old_stages = old_case->get("stages");
+            for (const StageStats& s : r.stages) {
+                const Json* old = old_stages ? old_stages->get(s.stage) : nullptr;
+                if (!old) continue;
+                double median = number_of(old->get("median"));
+                double ci_high = number_of(old->get("ci_high"));
+                double ci_low = number_of(old->get("ci_low"));
+                double ratio = median > 0 ? s.median / median : NAN;
+                const char* verdict = "ok";
+                if (ratio > 1 + threshold) {
+                    if (s.ci_low > ci_high) {
+                        verdict = "REGRESSION";
+                        problems++;
+                    } else {
+                        verdict = "slower (within noise)";
+                    }
+                } else if (ratio < 1 - threshold && s.ci_high < ci_low) {
+                    verdict = "faster";
+                }
+                std::printf("%-36s %-10s %12.3f %12.3f %8.3f  %s\n", r.name.c_str(), s.stage.c_str(),
+                            median, s.median, ratio, verdict);
+            }
+            const Json* old_checks = old_case->get("checks");
+            if (!same_instances) continue;
+            for (auto& check : r.checks) {
+                double old_value = number_of(old_checks ? old_checks->get(check.first) : nullptr);
+                if (!std::isnan(old_value) && old_value != check.second) {
+                    std::printf("%-36s check %s changed: %.17g -> %.17g\n", r.name.c_str(),
+                                check.first.c_str(), old_value, check.second);
+                    problems++;
+                }
+            }
+        }
+        return problems;
+    }
+};
+
+#endif
@@ -0,0 +1,214 @@
+/*
+ * Versioned binary instance files shared by both problems
+ * =======================================================
+ *
+ * A file is a fixed 176-byte header followed by up to 8 arrays
+ * ("sections"), each starting on a 64-byte boundary. The header records
+ * the file kind (8-byte magic), the format version, a byte-order mark, four
+ * kind-specific counts and the byte offset and length of every section.
+ * Arrays are stored in host byte order; the byte-order mark lets a reader
+ * reject files written on a machine with the other one.
+ *
+ * MappedFile maps a whole file read-only (mmap / MapViewOfFile), so a
+ * loader can point the solver straight at the sections: opening an
+ * instance costs page faults, not parsing.
+ */
+
+#ifndef INSTANCE_IO_H
+#define INSTANCE_IO_H
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+const uint32_t INSTANCE_FORMAT_VERSION = 1;
+const uint32_t INSTANCE_BYTE_ORDER = 0x01020304;
+const int INSTANCE_MAX_SECTIONS = 8;
+
+struct InstanceHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint64_t counts[4];
+    uint64_t section_offset[INSTANCE_MAX_SECTIONS];   // 0 = section absent
+    uint64_t section_bytes[INSTANCE_MAX_SECTIONS];
+};
+
+static_assert(sizeof(InstanceHeader) == 176, "InstanceHeader layout changed");
+
+// One array to write: pointer and size in bytes (size 0 = absent)
+struct InstanceSection {
+    const void* data;
+    uint64_t bytes;
+};
+
+// Write magic, counts and sections to path. Returns false on I/O errors.
+inline bool write_instance_file(const std::string& path, const char magic[8],
+                                const uint64_t counts[4],
+                                const std::vector<InstanceSection>& sections) {
+    InstanceHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, magic, 8);
+    header.version = INSTANCE_FORMAT_VERSION;
+    header.byte_order = INSTANCE_BYTE_ORDER;
+    for (int k = 0; k < 4; k++) header.counts[k] = counts[k];
+
+    uint64_t offset = (sizeof(header) + 63) / 64 * 64;
+    for (size_t k = 0; k < sections.size() && k < INSTANCE_MAX_SECTIONS; k++) {
+        if (sections[k].bytes == 0) continue;
+        header.section_offset[k] = offset;
+        header.section_bytes[k] = sections[k].bytes;
+        offset = (offset + sections[k].bytes + 63) / 64 * 64;
+    }
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out) return false;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    uint64_t written = sizeof(header);
+    static const char zeros[64] = {0};
+    for (size_t k = 0; k < sections.size() && k < INSTANCE_MAX_SECTIONS; k++) {
+        if (sections[k].bytes == 0) continue;
+        out.write(zeros, header.section_offset[k] - written);
+        out.write(static_cast<const char*>(sections[k].data), sections[k].bytes);
+        written = header.section_offset[k] + sections[k].bytes;
+    }
+    return (bool)out;
+}
+
+// Read-only mapping of a whole file; unmapped on destruction
+class MappedFile {
+private:
+    const char* base;
+    uint64_t length;
+#ifdef _WIN32
+    HANDLE file, mapping;
+#endif
+
+public:
+    MappedFile() : base(nullptr), length(0) {
+#ifdef _WIN32
+        file = INVALID_HANDLE_VALUE;
+        mapping = nullptr;
+#endif
+    }
+
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path) {
+        close();
+#ifdef _WIN32
+        file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                           OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+            close();
+            return false;
+        }
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) {
+            close();
+            return false;
+        }
+        base = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        if (!base) {
+            close();
+            return false;
+        }
+        length = size.QuadPart;
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size == 0) {
+            ::close(fd);
+            return false;
+        }
+        void* p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED) return false;
+        madvise(p, st.st_size, MADV_WILLNEED);
+        base = static_cast<const char*>(p);
+        length = st.st_size;
+#endif
+        return true;
+    }
+
+    void close() {
+#ifdef _WIN32
+        if (base) UnmapViewOfFile(base);
+        if (mapping) CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+        mapping = nullptr;
+        file = INVALID_HANDLE_VALUE;
+#else
+        if (base) munmap(const_cast<char*>(base), length);
+#endif
+        base = nullptr;
+        length = 0;
+    }
+
+    const char* data() const { return base; }
+    uint64_t size() const { return length; }
+};
+
+// Header of a mapped instance after checking magic, version, byte order and
+// that every section lies inside the file; nullptr (and error set) otherwise
+inline const InstanceHeader* check_instance_header(const MappedFile& file, const char magic[8],
+                                                   std::string& error) {
+    if (file.size() < sizeof(InstanceHeader)) {
+        error = "file too small for an instance header";
+        return nullptr;
+    }
+    const InstanceHeader* header = reinterpret_cast<const InstanceHeader*>(file.data());
+    if (std::memcmp(header->magic, magic, 8) != 0) {
+        error = "wrong file kind (magic " + std::string(header->magic, 8) + ")";
+        return nullptr;
+    }
+    if (header->byte_order != INSTANCE_BYTE_ORDER) {
+        error = "file written on a machine with another byte order";
+        return nullptr;
+    }
+    if (header->version != INSTANCE_FORMAT_VERSION) {
+        error = "unsupported format version " + std::to_string(header->version);
+        return nullptr;
+    }
+    for (int k = 0; k < INSTANCE_MAX_SECTIONS; k++) {
+        if (header->section_offset[k] % 64 != 0 || header->section_bytes[k] > file.size() ||
+            header->section_offset[k] > file.size() - header->section_bytes[k]) {
+            error = "section " + std::to_string(k) + " is out of bounds";
+            return nullptr;
+        }
+    }
+    return header;
+}
+
+// Point out at section k as an array of `count` T. False if the section's
+// length does not match (a section of 0 elements is stored absent).
+template <typename T>
+bool instance_section(const MappedFile& file, const InstanceHeader* header, int k,
+                      uint64_t count, const T*& out) {
+    out = nullptr;
+    if (header->section_bytes[k] != count * sizeof(T)) return false;
+    if (count > 0) out = reinterpret_cast<const T*>(file.data() + header->section_offset[k]);
+    return true;
+}
+
+#endif
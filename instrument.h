@@ -0,0 +1,42 @@
+/*
+ * Opt-in hot-path instrumentation shared by both problems
+ * =======================================================
+ *
+ * Compile with -DINSTRUMENT to count work inside the solvers (Dinic's
+ * BFS arcs and DFS advances, greedy gain evaluations, ...) and to time
+ * their stages. Without it the macros expand to nothing, so the hot
+ * loops are exactly the uninstrumented code and the counters stay 0.
+ *
+ *   INSTRUMENT_ADD(counter, amount)    counter += amount
+ *   INSTRUMENT_START(timer)            declare a steady_clock time point
+ *   INSTRUMENT_STOP(total_ms, timer)   total_ms += ms since the time point
+ *
+ * Benchmarks check `instrumented` and leave the counter columns empty
+ * when it is false.
+ */
+
+#ifndef INSTRUMENT_H
+#define INSTRUMENT_H
+
+#ifdef INSTRUMENT
+
+#include <chrono>
+
+const bool instrumented = true;
+
+#define INSTRUMENT_ADD(counter, amount) ((counter) += (amount))
+#define INSTRUMENT_START(timer) auto timer = std::chrono::steady_clock::now()
+#define INSTRUMENT_STOP(total_ms, timer) \
+    ((total_ms) += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - (timer)).count())
+
+#else
+
+const bool instrumented = false;
+
+#define INSTRUMENT_ADD(counter, amount) ((void)0)
+#define INSTRUMENT_START(timer) ((void)0)
+#define INSTRUMENT_STOP(total_ms, timer) ((void)0)
+
+#endif
+
+#endif
@@ -12,19 +12,40 @@
 #include <iostream>
 #include <vector>
 #include <queue>
+#include <deque>
 #include <algorithm>
 #include <cstring>
 #include <chrono>
 #include <random>
 #include <fstream>
+#include <memory>
+#include <atomic>
+#include <climits>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#include "thread_pool.h"
+#include "instance_io.h"
+#include "result_writer.h"
+#include "bench_harness.h"
+#include "instrument.h"
+#include "alloc_stats.h"
+#include "batch_pool.h"
 
 using namespace std;
 using namespace std::chrono;
 
 const int INF = 1e9;
 
-// Dinic's Algorithm for Maximum Flow
-class MaxFlow {
+// Outputs of the benchmark tables: CSV, plus the column dump with --columns
+int result_formats = RESULT_CSV;
+
+// Seed of every benchmark instance generator (--seed N), so runs repeat
+uint32_t benchmark_seed = 12345;
+
+// Dinic's Algorithm on the original adjacency-list layout (one vector per node).
+// Kept as the baseline for the layout benchmark.
+class AdjListMaxFlow {
 private:
     struct Edge {
         int to, rev;
@@ -34,6 +55,7 @@ private:
     vector<vector<Edge>> graph;
     vector<int> level, iter;
     int n;
+    int num_edges = 0;
     
     void bfs(int s) {
         fill(level.begin(), level.end(), -1);
@@ -55,7 +77,7 @@ private:
     
     int dfs(int v, int t, int f) {
         if (v == t) return f;
-        for (int& i = iter[v]; i < graph[v].size(); i++) {
+        for (int& i = iter[v]; i < (int)graph[v].size(); i++) {
             Edge& e = graph[v][i];
             if (e.cap > 0 && level[v] < level[e.to]) {
                 int d = dfs(e.to, t, min(f, e.cap));
@@ -70,11 +92,12 @@ private:
     }
     
 public:
-    MaxFlow(int n) : n(n), graph(n), level(n), iter(n) {}
+    AdjListMaxFlow(int n) : graph(n), level(n), iter(n), n(n) {}
     
-    void add_edge(int from, int to, int cap) {
+    int add_edge(int from, int to, int cap) {
         graph[from].push_back({to, (int)graph[to].size(), cap});
         graph[to].push_back({from, (int)graph[from].size() - 1, 0});
+        return num_edges++;
     }
     
     int max_flow(int s, int t) {
@@ -106,247 +129,3431 @@ public:
     }
 };
 
-// Ride-Share Assignment Problem
-class RideShareAssignment {
-private:
-    int num_drivers;
-    int num_requests;
-    vector<int> driver_capacities;
-    vector<vector<bool>> feasible_edges;
-    MaxFlow* flow_graph;
+// Per-run counters reported by MaxFlow
+struct FlowStats {
+    int phases = 0;                 // BFS level graphs built
+    long long augmentations = 0;    // Augmenting paths pushed
+    int scaling_rounds = 0;         // Thresholds tried by max_flow_scaling()
     
-    int source;
-    int sink;
-    int driver_offset;
-    int request_offset;
+    // Filled only when compiled with -DINSTRUMENT (see instrument.h)
+    long long bfs_arcs_scanned = 0; // Arcs examined while building level graphs
+    long long dfs_arcs_skipped = 0; // Non-admissible arcs the DFS passed over
+    long long dfs_advances = 0;     // Arcs the walk moved along
+    long long dfs_retreats = 0;     // Dead ends retreated from
+    double bfs_ms = 0;              // Wall time in bfs()
+    double augment_ms = 0;          // Wall time in blocking flows
     
-public:
-    RideShareAssignment(int m, int n) 
-        : num_drivers(m), num_requests(n) {
-        driver_capacities.resize(m, 1);
-        feasible_edges.resize(m, vector<bool>(n, false));
-        
-        // Node numbering: 0=source, 1..m=drivers, m+1..m+n=requests, m+n+1=sink
-        source = 0;
-        driver_offset = 1;
-        request_offset = driver_offset + num_drivers;
-        sink = request_offset + num_requests;
-        
-        flow_graph = nullptr;
+    double augmentations_per_phase() const {
+        return phases > 0 ? (double)augmentations / phases : 0.0;
     }
+};
+
+// Dinic's Algorithm for Maximum Flow
+//
+// The residual graph is built in two phases: add_edge() collects edges, then
+// freeze() packs them into a compressed sparse row (CSR) layout. Arcs are
+// stored as structure-of-arrays (edge_to, edge_cap, edge_rev) so the arcs of
+// a node are contiguous and the bfs/dfs loops walk flat arrays.
+//
+// bfs() and blocking_flow() only use arcs with at least min_residual units
+// left: 1 for plain Dinic, the current threshold in max_flow_scaling().
+class MaxFlow {
+private:
+    struct PendingEdge {
+        int from, to;
+        int cap, rev_cap;
+    };
     
-    ~RideShareAssignment() {
-        if (flow_graph) delete flow_graph;
-    }
+    int n;
+    bool frozen;
+    vector<PendingEdge> pending;    // Edges in insertion order
+    vector<int> edge_pos;           // edge_pos[k] = CSR slot of k-th forward arc
     
-    void set_driver_capacity(int driver_id, int capacity) {
-        driver_capacities[driver_id] = capacity;
-    }
+    // CSR residual graph: arcs of node v are [start[v], start[v + 1])
+    vector<int> start;
+    vector<int> edge_to, edge_cap, edge_rev;
+    vector<char> edge_forward;      // 1 for arcs added by add_edge, 0 for reverse arcs
     
-    void add_feasible_assignment(int driver_id, int request_id) {
-        feasible_edges[driver_id][request_id] = true;
-    }
+    vector<int> level, iter, bfs_queue;
+    vector<int> path;               // Arc stack of blocking_flow()
+    int min_residual;               // Smallest residual an arc needs to be used
+    FlowStats stats;
     
-    void build_flow_network() {
-        int total_nodes = num_drivers + num_requests + 2;
-        flow_graph = new MaxFlow(total_nodes);
-        
-        // Source to drivers
-        for (int i = 0; i < num_drivers; i++) {
-            flow_graph->add_edge(source, driver_offset + i, driver_capacities[i]);
+    // Multithreaded level-graph builder (enabled by set_threads)
+    unique_ptr<ThreadPool> pool;
+    unique_ptr<atomic<int>[]> shared_level;
+    int shared_size;                     // Entries in shared_level
+    vector<vector<int>> next_frontier;   // Per-worker output of one level
+    vector<long long> worker_arcs_scanned;
+    
+    void bfs(int s) {
+        if (pool) {
+            parallel_bfs(s);
+            return;
         }
+        fill(level.begin(), level.end(), -1);
+        const int delta = min_residual;
+        int head = 0, tail = 0;
+        level[s] = 0;
+        bfs_queue[tail++] = s;
         
-        // Drivers to requests
-        for (int i = 0; i < num_drivers; i++) {
-            for (int j = 0; j < num_requests; j++) {
-                if (feasible_edges[i][j]) {
-                    flow_graph->add_edge(driver_offset + i, request_offset + j, 1);
+        while (head < tail) {
+            int v = bfs_queue[head++];
+            INSTRUMENT_ADD(stats.bfs_arcs_scanned, start[v + 1] - start[v]);
+            for (int i = start[v]; i < start[v + 1]; i++) {
+                int u = edge_to[i];
+                if (edge_cap[i] >= delta && level[u] < 0) {
+                    level[u] = level[v] + 1;
+                    bfs_queue[tail++] = u;
                 }
             }
         }
-        
-        // Requests to sink
-        for (int j = 0; j < num_requests; j++) {
-            flow_graph->add_edge(request_offset + j, sink, 1);
-        }
     }
     
-    pair<int, vector<pair<int, int>>> solve() {
-        if (!flow_graph) {
-            build_flow_network();
-        }
+    // Level-synchronous BFS. Top-down steps claim level[] entries with a
+    // compare-and-swap; when the frontier's arcs exceed 1/14 of the arcs not
+    // yet explored the sweep switches to bottom-up, where every unvisited
+    // node looks for a residual arc from the frontier and only writes its own
+    // entry. Switches back once the frontier is under n/24 nodes.
+    void parallel_bfs(int s) {
+        const int ALPHA = 14, BETA = 24;
+        int workers = pool->size();
+        int total_arcs = start[n];
+        const int delta = min_residual;
         
-        int max_flow_value = flow_graph->max_flow(source, sink);
+        pool->run([&](int w) {
+            auto range = ThreadPool::chunk(n, workers, w);
+            for (int v = range.first; v < range.second; v++) {
+                shared_level[v].store(-1, memory_order_relaxed);
+            }
+        });
+        shared_level[s].store(0, memory_order_relaxed);
         
-        // Extract assignments
-        vector<pair<int, int>> assignments;
-        for (int i = 0; i < num_drivers; i++) {
-            for (int j = 0; j < num_requests; j++) {
-                if (feasible_edges[i][j]) {
-                    int flow = flow_graph->get_flow(driver_offset + i, request_offset + j);
-                    if (flow > 0) {
-                        assignments.push_back({i, j});
+        vector<int> frontier(1, s);
+        long long frontier_arcs = start[s + 1] - start[s];
+        long long unexplored_arcs = total_arcs - frontier_arcs;
+        bool bottom_up = false;
+        vector<long long> next_arcs(workers);
+        
+        for (int depth = 0; !frontier.empty(); depth++) {
+            if (!bottom_up && frontier_arcs * ALPHA > unexplored_arcs) {
+                bottom_up = true;
+            } else if (bottom_up && (long long)frontier.size() * BETA < n) {
+                bottom_up = false;
+            }
+            
+            pool->run([&](int w) {
+                vector<int>& out = next_frontier[w];
+                out.clear();
+                long long arcs = 0;
+                if (bottom_up) {
+                    auto range = ThreadPool::chunk(n, workers, w);
+                    for (int v = range.first; v < range.second; v++) {
+                        if (shared_level[v].load(memory_order_relaxed) >= 0) continue;
+                        for (int i = start[v]; i < start[v + 1]; i++) {
+                            INSTRUMENT_ADD(worker_arcs_scanned[w], 1);
+                            if (edge_cap[edge_rev[i]] >= delta &&
+                                shared_level[edge_to[i]].load(memory_order_relaxed) == depth) {
+                                shared_level[v].store(depth + 1, memory_order_relaxed);
+                                out.push_back(v);
+                                arcs += start[v + 1] - start[v];
+                                break;
+                            }
+                        }
+                    }
+                } else {
+                    auto range = ThreadPool::chunk(frontier.size(), workers, w);
+                    for (int k = range.first; k < range.second; k++) {
+                        int v = frontier[k];
+                        INSTRUMENT_ADD(worker_arcs_scanned[w], start[v + 1] - start[v]);
+                        for (int i = start[v]; i < start[v + 1]; i++) {
+                            int u = edge_to[i];
+                            int unvisited = -1;
+                            if (edge_cap[i] >= delta &&
+                                shared_level[u].load(memory_order_relaxed) < 0 &&
+                                shared_level[u].compare_exchange_strong(unvisited, depth + 1,
+                                                                       memory_order_relaxed)) {
+                                out.push_back(u);
+                                arcs += start[u + 1] - start[u];
+                            }
+                        }
                     }
                 }
+                next_arcs[w] = arcs;
+            });
+            
+            frontier.clear();
+            frontier_arcs = 0;
+            for (int w = 0; w < workers; w++) {
+                frontier.insert(frontier.end(), next_frontier[w].begin(), next_frontier[w].end());
+                frontier_arcs += next_arcs[w];
             }
+            unexplored_arcs -= frontier_arcs;
         }
         
-        return {max_flow_value, assignments};
+        pool->run([&](int w) {
+            auto range = ThreadPool::chunk(n, workers, w);
+            for (int v = range.first; v < range.second; v++) {
+                level[v] = shared_level[v].load(memory_order_relaxed);
+            }
+        });
+#ifdef INSTRUMENT
+        for (long long& arcs : worker_arcs_scanned) {
+            stats.bfs_arcs_scanned += arcs;
+            arcs = 0;
+        }
+#endif
     }
     
-    void print_stats() {
-        int num_edges = 0;
-        for (int i = 0; i < num_drivers; i++) {
-            for (int j = 0; j < num_requests; j++) {
-                if (feasible_edges[i][j]) num_edges++;
+    int dfs(int v, int t, int f) {
+        if (v == t) return f;
+        for (int& i = iter[v]; i < start[v + 1]; i++) {
+            int u = edge_to[i];
+            if (edge_cap[i] > 0 && level[v] < level[u]) {
+                INSTRUMENT_ADD(stats.dfs_advances, 1);
+                int d = dfs(u, t, min(f, edge_cap[i]));
+                if (d > 0) {
+                    edge_cap[i] -= d;
+                    edge_cap[edge_rev[i]] += d;
+                    return d;
+                }
+                INSTRUMENT_ADD(stats.dfs_retreats, 1);
+            } else {
+                INSTRUMENT_ADD(stats.dfs_arcs_skipped, 1);
             }
         }
+        return 0;
+    }
+    
+    // Blocking flow on the current level graph with an explicit stack of arcs.
+    // After each augmentation the walk retreats only to the tail of the first
+    // saturated arc, so several paths are pushed per descent from the source.
+    // Nodes whose arcs are exhausted are retreated from and never re-entered
+    // because their parent's iter[] moves past them. An arc left with less
+    // than min_residual counts as saturated.
+    int blocking_flow(int s, int t) {
+        const int delta = min_residual;
+        int flow = 0;
+        path.clear();
+        int v = s;
         
-        int total_nodes = num_drivers + num_requests + 2;
-        int total_edges = num_drivers + num_edges + num_requests;
-        
-        cout << "Flow Network Statistics:" << endl;
-        cout << "  Nodes: " << total_nodes << endl;
-        cout << "  Edges: " << total_edges << endl;
-        cout << "  Drivers: " << num_drivers << endl;
-        cout << "  Requests: " << num_requests << endl;
-        cout << "  Feasible edges: " << num_edges << endl;
+        while (true) {
+            if (v == t) {
+                int f = INF;
+                for (int i : path) f = min(f, edge_cap[i]);
+                int first_saturated = -1;
+                for (int k = 0; k < (int)path.size(); k++) {
+                    int i = path[k];
+                    edge_cap[i] -= f;
+                    edge_cap[edge_rev[i]] += f;
+                    if (first_saturated < 0 && edge_cap[i] < delta) first_saturated = k;
+                }
+                flow += f;
+                stats.augmentations++;
+                
+                path.resize(first_saturated);
+                v = path.empty() ? s : edge_to[path.back()];
+                continue;
+            }
+            
+            int& i = iter[v];
+            int end = start[v + 1];
+            while (i < end && !(edge_cap[i] >= delta && level[v] < level[edge_to[i]])) {
+                INSTRUMENT_ADD(stats.dfs_arcs_skipped, 1);
+                i++;
+            }
+            
+            if (i < end) {
+                INSTRUMENT_ADD(stats.dfs_advances, 1);
+                path.push_back(i);
+                v = edge_to[i];
+            } else {
+                // Dead end: retreat and skip the arc that led here
+                if (path.empty()) return flow;
+                INSTRUMENT_ADD(stats.dfs_retreats, 1);
+                path.pop_back();
+                v = path.empty() ? s : edge_to[path.back()];
+                iter[v]++;
+            }
+        }
     }
-};
-
-// Generate random instance
-RideShareAssignment* generate_random_instance(int num_drivers, int num_requests, 
-                                              double edge_probability, 
-                                              mt19937& rng) {
-    RideShareAssignment* problem = new RideShareAssignment(num_drivers, num_requests);
     
-    // Set driver capacities (all 1 for simplicity)
-    for (int i = 0; i < num_drivers; i++) {
-        problem->set_driver_capacity(i, 1);
+    // Dinic phases until t is unreachable over arcs with min_residual units
+    int dinic_phases(int s, int t) {
+        int flow = 0;
+        while (true) {
+            INSTRUMENT_START(bfs_timer);
+            bfs(s);
+            INSTRUMENT_STOP(stats.bfs_ms, bfs_timer);
+            if (level[t] < 0) return flow;
+            copy(start.begin(), start.end() - 1, iter.begin());
+            stats.phases++;
+            INSTRUMENT_START(augment_timer);
+            flow += blocking_flow(s, t);
+            INSTRUMENT_STOP(stats.augment_ms, augment_timer);
+        }
     }
     
-    // Generate feasible edges randomly
-    uniform_real_distribution<double> dist(0.0, 1.0);
-    for (int i = 0; i < num_drivers; i++) {
-        for (int j = 0; j < num_requests; j++) {
-            if (dist(rng) < edge_probability) {
-                problem->add_feasible_assignment(i, j);
-            }
+    // Copy residual capacities back into the pending list so the graph can be
+    // re-frozen after more edges are added without losing the current flow.
+    void thaw() {
+        for (int k = 0; k < (int)edge_pos.size(); k++) {
+            int slot = edge_pos[k];
+            pending[k].cap = edge_cap[slot];
+            pending[k].rev_cap = edge_cap[edge_rev[slot]];
         }
+        frozen = false;
     }
     
-    return problem;
-}
-
-// Benchmark runtime
-void benchmark_runtime(vector<int>& sizes, double edge_probability, 
-                      int trials, const string& output_file) {
-    ofstream out(output_file);
-    out << "size,runtime_ms,flow_value,num_edges" << endl;
+public:
+    MaxFlow(int n) : n(n), frozen(false), level(n), iter(n), bfs_queue(n), min_residual(1), shared_size(0) {}
     
-    random_device rd;
-    mt19937 rng(rd());
+    // Empty graph on n nodes that keeps every array's capacity (and the
+    // worker threads), so a graph rebuilt each tick stops allocating once
+    // it has seen its largest instance
+    void reset(int nodes) {
+        n = nodes;
+        frozen = false;
+        pending.clear();
+        edge_pos.clear();
+        level.resize(n);
+        iter.resize(n);
+        bfs_queue.resize(n);
+        stats = FlowStats();
+        if (pool && shared_size < n) {
+            shared_level.reset(new atomic<int>[n]);
+            shared_size = n;
+        }
+    }
     
-    for (int size : sizes) {
-        cout << "Benchmarking size " << size << "..." << endl;
+    // Build level graphs with this many threads (1 = sequential BFS)
+    void set_threads(int threads) {
+        if (threads <= 1) {
+            pool.reset();
+            shared_level.reset();
+            shared_size = 0;
+            return;
+        }
+        if (pool && pool->size() == threads && shared_size >= n) return;
+        pool.reset(new ThreadPool(threads));
+        shared_level.reset(new atomic<int>[n]);
+        shared_size = n;
+        next_frontier.assign(threads, vector<int>());
+        worker_arcs_scanned.assign(threads, 0);
+    }
+    
+    int threads() const {
+        return pool ? pool->size() : 1;
+    }
+    
+    // Returns a handle for edge_flow(); handles are assigned 0, 1, 2, ...
+    int add_edge(int from, int to, int cap) {
+        if (frozen) thaw();
+        pending.push_back({from, to, cap, 0});
+        return (int)pending.size() - 1;
+    }
+    
+    // Pack the collected edges into the CSR arrays. Arcs keep the same
+    // per-node order as the adjacency-list layout.
+    void freeze() {
+        if (frozen) return;
+        int m = pending.size();
         
-        for (int trial = 0; trial < trials; trial++) {
-            auto problem = generate_random_instance(size, size, edge_probability, rng);
-            
-            auto start = high_resolution_clock::now();
-            auto result = problem->solve();
-            auto end = high_resolution_clock::now();
-            
-            auto duration = duration_cast<microseconds>(end - start);
-            double runtime_ms = duration.count() / 1000.0;
-            
-            out << size << "," << runtime_ms << "," 
-                << result.first << "," << result.second.size() << endl;
-            
-            delete problem;
+        start.assign(n + 1, 0);
+        for (auto& e : pending) {
+            start[e.from + 1]++;
+            start[e.to + 1]++;
+        }
+        for (int v = 0; v < n; v++) {
+            start[v + 1] += start[v];
+        }
+        
+        edge_to.resize(2 * m);
+        edge_cap.resize(2 * m);
+        edge_rev.resize(2 * m);
+        edge_forward.resize(2 * m);
+        edge_pos.resize(m);
+        
+        vector<int> fill_pos(start.begin(), start.end() - 1);
+        for (int k = 0; k < m; k++) {
+            const PendingEdge& e = pending[k];
+            int a = fill_pos[e.from]++;
+            int b = fill_pos[e.to]++;
+            edge_to[a] = e.to;
+            edge_cap[a] = e.cap;
+            edge_rev[a] = b;
+            edge_forward[a] = 1;
+            edge_to[b] = e.from;
+            edge_cap[b] = e.rev_cap;
+            edge_rev[b] = a;
+            edge_forward[b] = 0;
+            edge_pos[k] = a;
         }
+        
+        frozen = true;
     }
     
-    out.close();
-    cout << "Results saved to " << output_file << endl;
-}
-
-// Demonstration example
-void demo_example() {
-    cout << "\n============================================================" << endl;
-    cout << "Demonstration: Small Example" << endl;
-    cout << "============================================================\n" << endl;
+    int max_flow(int s, int t) {
+        freeze();
+        stats = FlowStats();
+        return dinic_phases(s, t);
+    }
     
-    // Create small instance: 3 drivers, 4 requests
-    RideShareAssignment problem(3, 4);
+    // Capacity-scaling Dinic: Dinic restricted to arcs with at least delta
+    // residual units, for delta = the largest power of two not above the
+    // largest residual out of s and into t (no path carries more), then
+    // delta / 2, ..., 1. After a round at most (arcs) * delta units are left
+    // to find, so large capacities move in a few fat augmentations instead
+    // of many thin ones. The last round is plain Dinic, so the flow is
+    // maximum.
+    int max_flow_scaling(int s, int t) {
+        freeze();
+        stats = FlowStats();
+        int out_of_s = 0, into_t = 0;
+        for (int i = start[s]; i < start[s + 1]; i++) out_of_s = max(out_of_s, edge_cap[i]);
+        for (int i = start[t]; i < start[t + 1]; i++) into_t = max(into_t, edge_cap[edge_rev[i]]);
+        int largest = min(out_of_s, into_t);
+        int delta = 1;
+        while (delta <= largest / 2) delta *= 2;
+        
+        int flow = 0;
+        for (; delta >= 1; delta /= 2) {
+            min_residual = delta;
+            stats.scaling_rounds++;
+            flow += dinic_phases(s, t);
+        }
+        min_residual = 1;
+        return flow;
+    }
     
-    // Set capacities
-    for (int i = 0; i < 3; i++) {
-        problem.set_driver_capacity(i, 1);
+    // Dinic with the recursive single-path dfs(); reference implementation
+    // for differential testing of blocking_flow()
+    int max_flow_recursive(int s, int t) {
+        freeze();
+        stats = FlowStats();
+        int flow = 0;
+        while (true) {
+            INSTRUMENT_START(bfs_timer);
+            bfs(s);
+            INSTRUMENT_STOP(stats.bfs_ms, bfs_timer);
+            if (level[t] < 0) return flow;
+            copy(start.begin(), start.end() - 1, iter.begin());
+            stats.phases++;
+            INSTRUMENT_START(augment_timer);
+            int f;
+            while ((f = dfs(s, t, INF)) > 0) {
+                flow += f;
+                stats.augmentations++;
+            }
+            INSTRUMENT_STOP(stats.augment_ms, augment_timer);
+        }
     }
     
-    // Define feasible assignments
-    problem.add_feasible_assignment(0, 0);
-    problem.add_feasible_assignment(0, 1);
-    problem.add_feasible_assignment(1, 1);
-    problem.add_feasible_assignment(1, 2);
-    problem.add_feasible_assignment(2, 2);
-    problem.add_feasible_assignment(2, 3);
+    // Counters of the last max_flow() / max_flow_scaling() /
+    // max_flow_recursive() call
+    const FlowStats& last_stats() const {
+        return stats;
+    }
     
-    cout << "Problem Setup:" << endl;
-    cout << "  Drivers: 3 (each with capacity 1)" << endl;
-    cout << "  Requests: 4" << endl;
-    cout << "  Feasible assignments:" << endl;
-    cout << "    Driver 0 → Requests {0, 1}" << endl;
-    cout << "    Driver 1 → Requests {1, 2}" << endl;
-    cout << "    Driver 2 → Requests {2, 3}" << endl;
+    // Residual graph access for FlowSolver engines (valid after freeze())
+    int num_nodes() const { return n; }
+    int arc_begin(int v) const { return start[v]; }
+    int arc_end(int v) const { return start[v + 1]; }
+    int arc_head(int i) const { return edge_to[i]; }
+    int arc_residual(int i) const { return edge_cap[i]; }
+    int arc_reverse(int i) const { return edge_rev[i]; }
+    bool arc_is_forward(int i) const { return edge_forward[i]; }
     
-    // Solve
-    auto result = problem.solve();
-    int flow_value = result.first;
-    auto assignments = result.second;
+    // Original capacity of an arc (0 for reverse arcs)
+    int arc_capacity(int i) const {
+        return edge_forward[i] ? edge_cap[i] + edge_cap[edge_rev[i]] : 0;
+    }
     
-    cout << "\nSolution:" << endl;
-    cout << "  Maximum flow value: " << flow_value << endl;
-    cout << "  Assignments:" << endl;
-    for (auto& p : assignments) {
-        cout << "    Driver " << p.first << " → Request " << p.second << endl;
+    void push(int i, int d) {
+        edge_cap[i] -= d;
+        edge_cap[edge_rev[i]] += d;
     }
     
-    cout << endl;
-    problem.print_stats();
-}
+    // Push d units along the edge returned by add_edge() (initial flows)
+    void push_edge(int handle, int d) {
+        freeze();
+        push(edge_pos[handle], d);
+    }
+    
+    // Flow on the edge returned by add_edge(): the reverse arc's capacity
+    int edge_flow(int handle) {
+        freeze();
+        return edge_cap[edge_rev[edge_pos[handle]]];
+    }
+    
+    // Get flow on edge from -> to (linear scan of from's arcs)
+    int get_flow(int from, int to) {
+        freeze();
+        for (int i = start[from]; i < start[from + 1]; i++) {
+            if (edge_to[i] == to) {
+                return edge_cap[edge_rev[i]];  // Reverse edge capacity = flow
+            }
+        }
+        return 0;
+    }
+};
 
-int main(int argc, char* argv[]) {
-    cout << "============================================================" << endl;
-    cout << "Problem 1: Ride-Share Driver Assignment Experiments" << endl;
-    cout << "============================================================\n" << endl;
+// Common interface for max-flow engines. solve() augments the current flow
+// in the residual graph and returns the amount of flow added.
+class FlowSolver {
+public:
+    virtual ~FlowSolver() {}
+    virtual const char* name() const = 0;
+    virtual int solve(MaxFlow& graph, int s, int t) = 0;
+};
+
+class DinicSolver : public FlowSolver {
+public:
+    const char* name() const override { return "dinic"; }
     
-    // Run demonstration
-    demo_example();
+    int solve(MaxFlow& graph, int s, int t) override {
+        return graph.max_flow(s, t);
+    }
+};
+
+class ScalingDinicSolver : public FlowSolver {
+public:
+    const char* name() const override { return "dinic_scaling"; }
     
-    // Run benchmarks if requested
-    if (argc > 1 && string(argv[1]) == "--benchmark") {
-        cout << "\n============================================================" << endl;
-        cout << "Running Benchmarks" << endl;
-        cout << "============================================================\n" << endl;
+    int solve(MaxFlow& graph, int s, int t) override {
+        return graph.max_flow_scaling(s, t);
+    }
+};
+
+// Hopcroft-Karp for unit-capacity bipartite networks of the form
+// s -> L -> R -> t. Falls back to Dinic when the network has any other shape.
+class HopcroftKarpSolver : public FlowSolver {
+private:
+    vector<int> side;       // 0 = other, 1 = left, 2 = right
+    vector<int> match_arc;  // Left node -> matched arc into R, or -1
+    vector<int> match_of;   // Right node -> matched left node, or -1
+    vector<int> to_sink;    // Right node -> arc into t, or -1
+    vector<int> dist, iter, queue;
+    vector<int> left_nodes;
+    
+    bool classify(MaxFlow& g, int s, int t) {
+        int n = g.num_nodes();
+        side.assign(n, 0);
+        left_nodes.clear();
         
-        vector<int> sizes = {50, 100, 200, 300, 400, 500, 750, 1000};
-        vector<double> edge_probs = {0.1, 0.3, 0.5};
-        int trials = 5;
+        for (int i = g.arc_begin(s); i < g.arc_end(s); i++) {
+            int u = g.arc_head(i);
+            if (!g.arc_is_forward(i) || g.arc_capacity(i) != 1 || u == t || side[u]) return false;
+            side[u] = 1;
+            left_nodes.push_back(u);
+        }
+        for (int u : left_nodes) {
+            for (int i = g.arc_begin(u); i < g.arc_end(u); i++) {
+                int r = g.arc_head(i);
+                if (!g.arc_is_forward(i)) {
+                    if (r != s) return false;
+                    continue;
+                }
+                if (g.arc_capacity(i) != 1 || r == s || r == t || side[r] == 1) return false;
+                side[r] = 2;
+            }
+        }
+        for (int r = 0; r < n; r++) {
+            if (side[r] != 2) continue;
+            for (int i = g.arc_begin(r); i < g.arc_end(r); i++) {
+                int v = g.arc_head(i);
+                if (g.arc_is_forward(i) ? (v != t || g.arc_capacity(i) != 1) : side[v] != 1) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+    
+    // Arc r -> t, or -1 if r has no edge to the sink
+    int sink_arc(MaxFlow& g, int r, int t) {
+        for (int i = g.arc_begin(r); i < g.arc_end(r); i++) {
+            if (g.arc_is_forward(i) && g.arc_head(i) == t) return i;
+        }
+        return -1;
+    }
+    
+    bool bfs(MaxFlow& g) {
+        const int UNSEEN = INF;
+        bool found = false;
+        int head = 0, tail = 0;
+        for (int u : left_nodes) {
+            if (match_arc[u] < 0) {
+                dist[u] = 0;
+                queue[tail++] = u;
+            } else {
+                dist[u] = UNSEEN;
+            }
+        }
+        while (head < tail) {
+            int u = queue[head++];
+            for (int i = g.arc_begin(u); i < g.arc_end(u); i++) {
+                if (!g.arc_is_forward(i) || to_sink[g.arc_head(i)] < 0) continue;
+                int w = match_of[g.arc_head(i)];
+                if (w < 0) {
+                    found = true;
+                } else if (dist[w] == UNSEEN) {
+                    dist[w] = dist[u] + 1;
+                    queue[tail++] = w;
+                }
+            }
+        }
+        return found;
+    }
+    
+    bool dfs(MaxFlow& g, int u) {
+        for (int& i = iter[u]; i < g.arc_end(u); i++) {
+            if (!g.arc_is_forward(i)) continue;
+            int r = g.arc_head(i);
+            if (to_sink[r] < 0) continue;
+            int w = match_of[r];
+            if (w < 0 || (dist[w] == dist[u] + 1 && dfs(g, w))) {
+                match_arc[u] = i;
+                match_of[r] = u;
+                return true;
+            }
+        }
+        dist[u] = INF;
+        return false;
+    }
+    
+public:
+    const char* name() const override { return "hopcroft_karp"; }
+    
+    int solve(MaxFlow& g, int s, int t) override {
+        g.freeze();
+        if (!classify(g, s, t)) {
+            return g.max_flow(s, t);
+        }
         
-        for (double p : edge_probs) {
-            cout << "\nEdge probability p = " << p << endl;
-            string filename = "data/flow_p" + to_string((int)(p * 10)) + ".csv";
-            benchmark_runtime(sizes, p, trials, filename);
+        int n = g.num_nodes();
+        match_arc.assign(n, -1);
+        match_of.assign(n, -1);
+        dist.assign(n, INF);
+        iter.assign(n, 0);
+        queue.resize(n);
+        
+        // Right nodes without a sink edge can never be matched
+        to_sink.assign(n, -1);
+        for (int r = 0; r < n; r++) {
+            if (side[r] == 2) to_sink[r] = sink_arc(g, r, t);
+        }
+        
+        // Start from the flow already in the residual graph
+        int initial = 0;
+        for (int u : left_nodes) {
+            for (int i = g.arc_begin(u); i < g.arc_end(u); i++) {
+                if (g.arc_is_forward(i) && g.arc_residual(i) == 0) {
+                    match_arc[u] = i;
+                    match_of[g.arc_head(i)] = u;
+                    initial++;
+                }
+            }
+        }
+        
+        int matched = initial;
+        while (bfs(g)) {
+            for (int u : left_nodes) iter[u] = g.arc_begin(u);
+            for (int u : left_nodes) {
+                if (match_arc[u] < 0 && dfs(g, u)) matched++;
+            }
+        }
+        
+        // Write the matching back into the residual graph
+        for (int i = g.arc_begin(s); i < g.arc_end(s); i++) {
+            int u = g.arc_head(i);
+            int want = match_arc[u] >= 0 ? 1 : 0;
+            g.push(i, want - (1 - g.arc_residual(i)));
+            for (int a = g.arc_begin(u); a < g.arc_end(u); a++) {
+                if (!g.arc_is_forward(a)) continue;
+                int flow = 1 - g.arc_residual(a);
+                g.push(a, (a == match_arc[u] ? 1 : 0) - flow);
+            }
+        }
+        for (int r = 0; r < n; r++) {
+            if (side[r] != 2 || to_sink[r] < 0) continue;
+            int flow = 1 - g.arc_residual(to_sink[r]);
+            g.push(to_sink[r], (match_of[r] >= 0 ? 1 : 0) - flow);
         }
         
-        cout << "\n============================================================" << endl;
-        cout << "Benchmarks completed!" << endl;
-        cout << "Run Python script to generate plots from CSV data." << endl;
-        cout << "============================================================" << endl;
+        return matched - initial;
+    }
+};
+
+// FIFO push-relabel with periodic global relabeling. Heights come from a
+// reverse BFS from t (and from s for nodes that can no longer reach t), so
+// excess that cannot reach the sink is returned to the source and the
+// result is a valid flow.
+class PushRelabelSolver : public FlowSolver {
+private:
+    vector<int> height, excess, current;
+    vector<char> in_queue;
+    vector<int> bfs_queue;
+    
+    void global_relabel(MaxFlow& g, int s, int t) {
+        int n = g.num_nodes();
+        fill(height.begin(), height.end(), 2 * n);
+        
+        // Distance to t, then distance to s (offset by n) for the rest
+        int roots[2] = {t, s};
+        for (int pass = 0; pass < 2; pass++) {
+            int root = roots[pass];
+            int head = 0, tail = 0;
+            height[root] = pass == 0 ? 0 : n;
+            bfs_queue[tail++] = root;
+            while (head < tail) {
+                int u = bfs_queue[head++];
+                for (int i = g.arc_begin(u); i < g.arc_end(u); i++) {
+                    int v = g.arc_head(i);
+                    if (g.arc_residual(g.arc_reverse(i)) > 0 && height[v] == 2 * n
+                        && v != s && v != t) {
+                        height[v] = height[u] + 1;
+                        bfs_queue[tail++] = v;
+                    }
+                }
+            }
+        }
+        
+        for (int v = 0; v < n; v++) current[v] = g.arc_begin(v);
+    }
+    
+public:
+    const char* name() const override { return "push_relabel"; }
+    
+    int solve(MaxFlow& g, int s, int t) override {
+        g.freeze();
+        int n = g.num_nodes();
+        height.assign(n, 0);
+        excess.assign(n, 0);
+        current.assign(n, 0);
+        in_queue.assign(n, 0);
+        bfs_queue.resize(n);
+        
+        global_relabel(g, s, t);
+        height[s] = n;
+        
+        queue<int> active;
+        for (int i = g.arc_begin(s); i < g.arc_end(s); i++) {
+            int d = g.arc_residual(i);
+            if (d <= 0) continue;
+            int v = g.arc_head(i);
+            g.push(i, d);
+            excess[v] += d;
+            excess[s] -= d;
+            if (v != t && !in_queue[v]) {
+                in_queue[v] = 1;
+                active.push(v);
+            }
+        }
+        
+        long long relabel_work = 0;
+        while (!active.empty()) {
+            int v = active.front();
+            active.pop();
+            in_queue[v] = 0;
+            
+            while (excess[v] > 0) {
+                if (current[v] == g.arc_end(v)) {
+                    // Relabel to one above the lowest residual neighbour
+                    int min_height = 2 * n;
+                    for (int i = g.arc_begin(v); i < g.arc_end(v); i++) {
+                        if (g.arc_residual(i) > 0) {
+                            min_height = min(min_height, height[g.arc_head(i)]);
+                        }
+                    }
+                    height[v] = min_height + 1;
+                    current[v] = g.arc_begin(v);
+                    relabel_work += g.arc_end(v) - g.arc_begin(v) + 12;
+                    continue;
+                }
+                
+                int i = current[v];
+                int u = g.arc_head(i);
+                if (g.arc_residual(i) > 0 && height[v] == height[u] + 1) {
+                    int d = min(excess[v], g.arc_residual(i));
+                    g.push(i, d);
+                    excess[v] -= d;
+                    excess[u] += d;
+                    if (u != s && u != t && !in_queue[u]) {
+                        in_queue[u] = 1;
+                        active.push(u);
+                    }
+                } else {
+                    current[v]++;
+                }
+            }
+            
+            // Global relabel after O(m + n) relabel work
+            if (relabel_work > 6LL * n + g.arc_end(n - 1)) {
+                global_relabel(g, s, t);
+                relabel_work = 0;
+            }
+        }
+        
+        return excess[t];
+    }
+};
+
+enum class FlowEngine {
+    AUTO,           // Hopcroft-Karp for unit-capacity instances, else Dinic
+    DINIC,
+    DINIC_SCALING,  // Capacity-scaling Dinic (MaxFlow::max_flow_scaling)
+    HOPCROFT_KARP,
+    PUSH_RELABEL
+};
+
+unique_ptr<FlowSolver> make_flow_solver(FlowEngine engine) {
+    switch (engine) {
+        case FlowEngine::DINIC_SCALING: return unique_ptr<FlowSolver>(new ScalingDinicSolver());
+        case FlowEngine::HOPCROFT_KARP: return unique_ptr<FlowSolver>(new HopcroftKarpSolver());
+        case FlowEngine::PUSH_RELABEL: return unique_ptr<FlowSolver>(new PushRelabelSolver());
+        default: return unique_ptr<FlowSolver>(new DinicSolver());
+    }
+}
+
+// Min-Cost Flow from supply nodes to a single sink by cost scaling
+//
+// Goldberg-Tarjan successive approximation: costs are multiplied by n + 1,
+// so an eps-optimal flow (every residual arc has reduced cost
+// cost + price[u] - price[v] >= -eps) is optimal once eps reaches 1. Each
+// refine divides eps by `alpha`, saturates the arcs that became negative and
+// then moves the resulting excess to the deficits with partial augmentations
+// (LEMON's variant of push-relabel): from an active node, walk admissible
+// arcs (residual, negative reduced cost) for at most `max_path` steps,
+// relabelling and stepping back at dead ends, then push along the path.
+// Global price updates (a bucket-based Dijkstra from the deficits, in units
+// of eps) run at the start of each refine and after every `update_factor * n`
+// relabels; they also detect supply that cannot reach the sink. Unlike
+// successive shortest paths, no step searches the whole graph for a single
+// augmenting path, so the last, longest augmentations stay cheap. Edge costs
+// must be non-negative, and cost * (n + 1) must fit comfortably in 64 bits.
+class MinCostFlow {
+private:
+    struct PendingEdge {
+        int from, to;
+        int cap;
+        long long cost;
+    };
+    
+    static const int alpha = 32;
+    static const int max_path = 16;
+    static const int update_factor = 2;
+    
+    int n;
+    bool frozen;
+    vector<PendingEdge> pending;
+    vector<int> edge_pos;
+    vector<int> supply;
+    
+    // CSR residual graph, same layout as MaxFlow plus per-arc scaled cost and
+    // the capacity of the arc pair (so the reverse arc's residual capacity is
+    // pair_cap - edge_cap without touching it)
+    vector<int> start;
+    vector<int> edge_to, edge_cap, edge_rev, pair_cap;
+    vector<long long> edge_cost;
+    
+    vector<long long> price, excess;
+    vector<int> current;
+    vector<int> bucket_rank, bucket_head, bucket_next, bucket_prev;
+    deque<int> active;
+    vector<int> path, path_arc;
+    long long refines, relabels, price_updates;
+    
+    void bucket_insert(int v, int r) {
+        bucket_rank[v] = r;
+        bucket_prev[v] = -1;
+        bucket_next[v] = bucket_head[r];
+        if (bucket_head[r] >= 0) bucket_prev[bucket_head[r]] = v;
+        bucket_head[r] = v;
+    }
+    
+    void bucket_remove(int v) {
+        if (bucket_prev[v] >= 0) {
+            bucket_next[bucket_prev[v]] = bucket_next[v];
+        } else {
+            bucket_head[bucket_rank[v]] = bucket_next[v];
+        }
+        if (bucket_next[v] >= 0) bucket_prev[bucket_next[v]] = bucket_prev[v];
+    }
+    
+    // Lower every price by eps * (distance to the nearest deficit), with arc
+    // length floor(reduced cost / eps) + 1 and distances capped at n
+    // (shortening an arc keeps the prices eps-optimal). Buckets are processed
+    // until all excess has been reached; the rest get the next rank. False
+    // when some excess cannot reach any deficit.
+    bool global_update(long long eps) {
+        price_updates++;
+        const int unreached = n + 1;
+        bucket_rank.assign(n, unreached);
+        bucket_head.assign(n + 1, -1);
+        long long remaining = 0;
+        for (int v = 0; v < n; v++) {
+            if (excess[v] < 0) bucket_insert(v, 0);
+            else remaining += excess[v];
+        }
+        
+        int r = 0;
+        for (; r <= n && remaining > 0; r++) {
+            while (bucket_head[r] >= 0) {
+                int u = bucket_head[r];
+                bucket_remove(u);
+                bucket_rank[u] = -1 - r;    // Done
+                if (excess[u] > 0) remaining -= excess[u];
+                // Arcs v -> u: reverses of u's arcs with residual capacity
+                for (int i = start[u]; i < start[u + 1]; i++) {
+                    if (edge_cap[i] >= pair_cap[i]) continue;
+                    int v = edge_to[i];
+                    if (bucket_rank[v] < 0) continue;
+                    long long reduced = price[v] - edge_cost[i] - price[u];
+                    long long steps = reduced >= 0 ? reduced / eps : -1;
+                    int new_rank = (int)min<long long>(n, r + 1 + steps);
+                    if (new_rank < bucket_rank[v]) {
+                        if (bucket_rank[v] < unreached) bucket_remove(v);
+                        bucket_insert(v, new_rank);
+                    }
+                }
+            }
+        }
+        if (remaining > 0) return false;
+        
+        for (int v = 0; v < n; v++) {
+            int d = bucket_rank[v] < 0 ? -1 - bucket_rank[v] : min(bucket_rank[v], r);
+            price[v] -= eps * d;
+        }
+        return true;
+    }
+    
+    // Lower price[u] until an arc leaves it admissible. `back` is the reverse
+    // of the path arc into u (or -1), counted even without residual capacity
+    // so that arc stops being admissible when u has no other way out.
+    void relabel(int u, int back, long long eps) {
+        long long lowest = numeric_limits<long long>::max();
+        for (int i = start[u]; i < start[u + 1]; i++) {
+            if (edge_cap[i] > 0) lowest = min(lowest, edge_cost[i] + price[u] - price[edge_to[i]]);
+        }
+        if (lowest == numeric_limits<long long>::max()) {
+            lowest = back >= 0 ? edge_cost[back] + price[u] - price[edge_to[back]] : 0;
+        }
+        price[u] -= lowest + eps;
+        current[u] = start[u];
+        relabels++;
+    }
+    
+    void push(int i, int u, long long amount) {
+        int w = edge_to[i];
+        edge_cap[i] -= amount;
+        edge_cap[edge_rev[i]] += amount;
+        excess[u] -= amount;
+        if (excess[w] <= 0 && excess[w] + amount > 0) active.push_back(w);
+        excess[w] += amount;
+    }
+    
+    // Turn an eps * alpha-optimal flow into an eps-optimal one
+    bool refine(long long eps) {
+        refines++;
+        for (int u = 0; u < n; u++) {
+            for (int i = start[u]; i < start[u + 1]; i++) {
+                if (edge_cap[i] > 0 && edge_cost[i] + price[u] - price[edge_to[i]] < 0) {
+                    int amount = edge_cap[i];
+                    edge_cap[i] = 0;
+                    edge_cap[edge_rev[i]] += amount;
+                    excess[u] -= amount;
+                    excess[edge_to[i]] += amount;
+                }
+            }
+        }
+        if (!global_update(eps)) return false;
+        
+        active.clear();
+        for (int v = 0; v < n; v++) {
+            if (excess[v] > 0) active.push_back(v);
+        }
+        current.assign(start.begin(), start.end() - 1);
+        long long update_at = relabels + (long long)update_factor * n;
+        
+        while (!active.empty()) {
+            int s = active.front();
+            if (excess[s] <= 0) {
+                active.pop_front();
+                continue;
+            }
+            
+            // Walk admissible arcs until a deficit or the length limit
+            path.assign(1, s);
+            path_arc.clear();
+            int tip = s;
+            while ((int)path_arc.size() < max_path && excess[tip] >= 0 && relabels < update_at) {
+                int i = current[tip];
+                for (; i < start[tip + 1]; i++) {
+                    if (edge_cap[i] > 0 && edge_cost[i] + price[tip] - price[edge_to[i]] < 0) break;
+                }
+                current[tip] = i;
+                if (i < start[tip + 1]) {
+                    path_arc.push_back(i);
+                    tip = edge_to[i];
+                    path.push_back(tip);
+                } else {
+                    relabel(tip, tip != s ? edge_rev[path_arc.back()] : -1, eps);
+                    if (tip != s) {
+                        path.pop_back();
+                        path_arc.pop_back();
+                        tip = path.back();
+                    }
+                }
+            }
+            
+            for (size_t k = 0; k < path_arc.size(); k++) {
+                int i = path_arc[k];
+                long long amount = min(excess[path[k]], (long long)edge_cap[i]);
+                if (amount <= 0) break;
+                push(i, path[k], amount);
+            }
+            
+            if (relabels >= update_at) {
+                global_update(eps);
+                current.assign(start.begin(), start.end() - 1);
+                update_at = relabels + (long long)update_factor * n;
+            }
+        }
+        return true;
+    }
+    
+public:
+    MinCostFlow(int n) : n(n), frozen(false), supply(n, 0), refines(0), relabels(0), price_updates(0) {}
+    
+    // Returns a handle for edge_flow(); handles are assigned 0, 1, 2, ...
+    int add_edge(int from, int to, int cap, long long cost) {
+        pending.push_back({from, to, cap, cost});
+        frozen = false;
+        return (int)pending.size() - 1;
+    }
+    
+    void set_supply(int v, int amount) {
+        supply[v] = amount;
+    }
+    
+    void freeze() {
+        if (frozen) return;
+        int m = pending.size();
+        
+        start.assign(n + 1, 0);
+        for (auto& e : pending) {
+            start[e.from + 1]++;
+            start[e.to + 1]++;
+        }
+        for (int v = 0; v < n; v++) {
+            start[v + 1] += start[v];
+        }
+        
+        edge_to.resize(2 * m);
+        edge_cap.resize(2 * m);
+        edge_rev.resize(2 * m);
+        pair_cap.resize(2 * m);
+        edge_cost.resize(2 * m);
+        edge_pos.resize(m);
+        
+        long long scale = n + 1;
+        vector<int> fill_pos(start.begin(), start.end() - 1);
+        for (int k = 0; k < m; k++) {
+            const PendingEdge& e = pending[k];
+            int a = fill_pos[e.from]++;
+            int b = fill_pos[e.to]++;
+            edge_to[a] = e.to;
+            edge_cap[a] = e.cap;
+            edge_cost[a] = e.cost * scale;
+            edge_rev[a] = b;
+            edge_to[b] = e.from;
+            edge_cap[b] = 0;
+            edge_cost[b] = -e.cost * scale;
+            edge_rev[b] = a;
+            pair_cap[a] = pair_cap[b] = e.cap;
+            edge_pos[k] = a;
+        }
+        
+        price.assign(n, 0);
+        excess.assign(n, 0);
+        bucket_next.resize(n);
+        bucket_prev.resize(n);
+        frozen = true;
+    }
+    
+    // Route all supply to t at minimum total cost; returns that cost, or -1
+    // when some supply cannot reach t
+    long long solve(int t) {
+        freeze();
+        long long total_supply = 0;
+        for (int v = 0; v < n; v++) {
+            excess[v] += supply[v];
+            total_supply += supply[v];
+            supply[v] = 0;
+        }
+        excess[t] -= total_supply;
+        
+        long long eps = 1;
+        for (long long c : edge_cost) eps = max(eps, c);
+        do {
+            eps = max(eps / alpha, 1LL);
+            if (!refine(eps)) return -1;
+        } while (eps > 1);
+        
+        long long cost = 0;
+        for (int k = 0; k < (int)edge_pos.size(); k++) {
+            cost += edge_flow(k) * pending[k].cost;
+        }
+        return cost;
+    }
+    
+    // Flow on the edge with this handle
+    int edge_flow(int handle) const {
+        return edge_cap[edge_rev[edge_pos[handle]]];
+    }
+    
+    // Refines (eps phases), relabels and global price updates so far
+    long long refine_count() const { return refines; }
+    long long relabel_count() const { return relabels; }
+    long long price_update_count() const { return price_updates; }
+};
+
+// Uniform grid over a point set for fixed-radius neighbour queries
+//
+// Points are bucketed by cell with a counting sort (CSR again: cell_start /
+// cell_items), so building is O(points + cells). The cell side is the query
+// radius, enlarged when needed to keep the number of cells at most about the
+// number of points, so a query scans the few cells overlapping the disk and
+// costs O(1 + points in those cells).
+class SpatialGrid {
+private:
+    const vector<double>& xs;
+    const vector<double>& ys;
+    double min_x, min_y, cell;
+    int cols, rows;
+    vector<int> cell_start, cell_items;
+    
+    int column(double x) const {
+        return max(0, min(cols - 1, (int)((x - min_x) / cell)));
+    }
+    
+    int row(double y) const {
+        return max(0, min(rows - 1, (int)((y - min_y) / cell)));
+    }
+    
+public:
+    SpatialGrid(const vector<double>& xs, const vector<double>& ys, double radius)
+        : xs(xs), ys(ys), min_x(0), min_y(0), cell(1), cols(1), rows(1) {
+        int n = xs.size();
+        if (n > 0) {
+            min_x = *min_element(xs.begin(), xs.end());
+            min_y = *min_element(ys.begin(), ys.end());
+            double width = *max_element(xs.begin(), xs.end()) - min_x;
+            double height = *max_element(ys.begin(), ys.end()) - min_y;
+            // Keeps cols * rows = O(n) even for thin or degenerate extents
+            cell = max({radius, sqrt(max(width * height, 1e-12) / n), max(width, height) / n});
+            cols = (int)(width / cell) + 1;
+            rows = (int)(height / cell) + 1;
+        }
+        
+        cell_start.assign((size_t)cols * rows + 1, 0);
+        vector<int> cell_of(n);
+        for (int i = 0; i < n; i++) {
+            cell_of[i] = row(ys[i]) * cols + column(xs[i]);
+            cell_start[cell_of[i] + 1]++;
+        }
+        for (size_t c = 0; c + 1 < cell_start.size(); c++) {
+            cell_start[c + 1] += cell_start[c];
+        }
+        cell_items.resize(n);
+        vector<int> fill_pos(cell_start.begin(), cell_start.end() - 1);
+        for (int i = 0; i < n; i++) {
+            cell_items[fill_pos[cell_of[i]]++] = i;
+        }
+    }
+    
+    // Calls visit(i, squared_distance) for every point within radius of (x, y)
+    template <typename Visit>
+    void for_each_within(double x, double y, double radius, Visit visit) const {
+        if (cell_items.empty()) return;
+        double r2 = radius * radius;
+        int c0 = column(x - radius), c1 = column(x + radius);
+        int r0 = row(y - radius), r1 = row(y + radius);
+        for (int r = r0; r <= r1; r++) {
+            for (int c = c0; c <= c1; c++) {
+                int cell_id = r * cols + c;
+                for (int k = cell_start[cell_id]; k < cell_start[cell_id + 1]; k++) {
+                    int i = cell_items[k];
+                    double dx = xs[i] - x, dy = ys[i] - y;
+                    double d2 = dx * dx + dy * dy;
+                    if (d2 <= r2) visit(i, d2);
+                }
+            }
+        }
+    }
+};
+
+// Initial flow for a bipartite b-matching (drivers with capacities, requests
+// with seats) by Karp-Sipser: a driver or request with a single usable
+// partner is served by it as far as possible, which some maximum flow
+// always does; when no such vertex is left, the next driver with spare
+// capacity takes its first usable request (greedy), and the degree-1 rule
+// runs again on whatever that exposed. A pair is usable while both ends
+// have capacity left, so each vertex dies once and each dying vertex
+// updates its neighbours' degrees once: O(m + n + E) in total.
+class KarpSipserSeeder {
+public:
+    struct Stats {
+        long long degree_one_flow = 0;  // Units placed by the degree-1 rule
+        long long greedy_flow = 0;      // Units placed by the greedy step
+        
+        long long total() const { return degree_one_flow + greedy_flow; }
+    };
+    
+private:
+    int m;
+    const int* driver_start;        // Pairs of driver i: [driver_start[i], driver_start[i + 1])
+    const int* pair_request;
+    vector<int> request_start, request_pairs;   // Pairs of each request (CSR)
+    vector<int> driver_left, request_left;      // Capacity not yet used
+    vector<int> driver_degree, request_degree;  // Usable pairs
+    vector<int> cursor;                         // Greedy: next pair to try per driver
+    vector<int> queue;                          // Degree-1 vertices: drivers i, requests m + j
+    vector<int> pair_driver;
+    vector<int> flow;
+    Stats stats;
+    
+    void kill_driver(int i) {
+        for (int k = driver_start[i]; k < driver_start[i + 1]; k++) {
+            int j = pair_request[k];
+            if (request_left[j] > 0 && --request_degree[j] == 1) queue.push_back(m + j);
+        }
+    }
+    
+    void kill_request(int j) {
+        for (int p = request_start[j]; p < request_start[j + 1]; p++) {
+            int i = pair_driver[request_pairs[p]];
+            if (driver_left[i] > 0 && --driver_degree[i] == 1) queue.push_back(i);
+        }
+    }
+    
+    // Serve pair k as far as both ends allow; at least one end dies
+    long long assign(int k) {
+        int i = pair_driver[k], j = pair_request[k];
+        int units = min(driver_left[i], request_left[j]);
+        flow[k] += units;
+        driver_left[i] -= units;
+        request_left[j] -= units;
+        if (driver_left[i] == 0) kill_driver(i);
+        if (request_left[j] == 0) kill_request(j);
+        return units;
+    }
+    
+    void degree_one_rule() {
+        while (!queue.empty()) {
+            int v = queue.back();
+            queue.pop_back();
+            int k = -1;
+            if (v < m) {
+                if (driver_left[v] == 0 || driver_degree[v] != 1) continue;
+                for (int p = driver_start[v]; p < driver_start[v + 1] && k < 0; p++) {
+                    if (request_left[pair_request[p]] > 0) k = p;
+                }
+            } else {
+                int j = v - m;
+                if (request_left[j] == 0 || request_degree[j] != 1) continue;
+                for (int p = request_start[j]; p < request_start[j + 1] && k < 0; p++) {
+                    if (driver_left[pair_driver[request_pairs[p]]] > 0) k = request_pairs[p];
+                }
+            }
+            if (k >= 0) stats.degree_one_flow += assign(k);
+        }
+    }
+    
+public:
+    // Pairs are given driver by driver as CSR (driver_start has m + 1
+    // entries, pair_request one per pair); pair_flow() then holds the
+    // units placed on each pair. Returns the total.
+    long long run(const vector<int>& driver_cap, const vector<int>& request_cap,
+                  const int* start, const int* requests) {
+        m = driver_cap.size();
+        int n = request_cap.size();
+        int pairs = start[m];
+        driver_start = start;
+        pair_request = requests;
+        stats = Stats();
+        
+        driver_left.assign(driver_cap.begin(), driver_cap.end());
+        request_left.assign(request_cap.begin(), request_cap.end());
+        for (int& c : driver_left) c = max(c, 0);
+        for (int& c : request_left) c = max(c, 0);
+        driver_degree.assign(m, 0);
+        request_degree.assign(n, 0);
+        request_start.assign(n + 1, 0);
+        pair_driver.resize(pairs);
+        flow.assign(pairs, 0);
+        for (int i = 0; i < m; i++) {
+            for (int k = start[i]; k < start[i + 1]; k++) {
+                int j = requests[k];
+                pair_driver[k] = i;
+                request_start[j + 1]++;
+                if (driver_left[i] > 0 && request_left[j] > 0) {
+                    driver_degree[i]++;
+                    request_degree[j]++;
+                }
+            }
+        }
+        for (int j = 0; j < n; j++) request_start[j + 1] += request_start[j];
+        request_pairs.resize(pairs);
+        cursor.assign(request_start.begin(), request_start.end() - 1);
+        for (int k = 0; k < pairs; k++) request_pairs[cursor[requests[k]]++] = k;
+        
+        queue.clear();
+        for (int i = 0; i < m; i++) {
+            if (driver_left[i] > 0 && driver_degree[i] == 1) queue.push_back(i);
+        }
+        for (int j = 0; j < n; j++) {
+            if (request_left[j] > 0 && request_degree[j] == 1) queue.push_back(m + j);
+        }
+        degree_one_rule();
+        
+        cursor.assign(start, start + m);
+        for (int i = 0; i < m; i++) {
+            while (driver_left[i] > 0) {
+                int& k = cursor[i];
+                while (k < start[i + 1] && request_left[requests[k]] == 0) k++;
+                if (k == start[i + 1]) break;
+                stats.greedy_flow += assign(k);
+                degree_one_rule();
+            }
+        }
+        return stats.total();
+    }
+    
+    int pair_flow(int k) const { return flow[k]; }
+    const Stats& last_stats() const { return stats; }
+};
+
+// How RideShareAssignment stores the feasible driver/request pairs
+enum class FeasibilityModel {
+    SPARSE,  // Per-driver request lists: O(m + E) memory and build time
+    DENSE,   // m x n bool matrix: duplicate-free, only for small instances
+    MAPPED   // CSR arrays of a mapped instance file (load_instance), read in place
+};
+
+// Magic of ride-share instance files (see instance_io.h). Sections:
+// 0 driver capacities, 1 CSR offsets (m + 1), 2 request ids, 3 costs
+// (absent when all are 0), 4 request seats (absent when all are 1); all
+// int32. Counts: drivers, requests, pairs.
+const char RIDESHARE_MAGIC[8] = {'R', 'I', 'D', 'E', 'S', 'H', 'R', '1'};
+
+// Ride-Share Assignment Problem
+//
+// Drivers have seat capacities and requests a number of seats (both 1 by
+// default). A request's seats may be split over several drivers, and a
+// driver/request pair carries at most min(driver capacity, request seats),
+// so the flow value counts seats served.
+class RideShareAssignment {
+private:
+    int num_drivers;
+    int num_requests;
+    vector<int> driver_capacities;
+    vector<int> request_capacities;          // Seats of each request
+    FeasibilityModel model;
+    vector<vector<int>> feasible_requests;   // SPARSE: requests of each driver
+    vector<vector<int>> feasible_costs;      // SPARSE: cost of each of those pairs
+    vector<vector<bool>> feasible_edges;     // DENSE: adjacency matrix
+    vector<vector<int>> cost_matrix;         // DENSE: allocated on first non-zero cost
+    shared_ptr<MappedFile> mapping;          // MAPPED: the file the arrays below live in
+    const int* mapped_start;                 // MAPPED: CSR offsets, m + 1
+    const int* mapped_requests;              // MAPPED: request of each pair
+    const int* mapped_costs;                 // MAPPED: cost of each pair, or nullptr (all 0)
+    int num_feasible;
+    MaxFlow* flow_graph;
+    bool network_built;      // flow_graph holds the current instance
+    bool flow_started;       // compute_flow() ran on flow_graph since it was built
+    vector<int> pair_edges;  // Flow graph handle of each feasible pair
+    unique_ptr<FlowSolver> solver;   // Kept between compute_flow() calls
+    FlowEngine solver_engine;
+    FlowEngine engine;
+    int bfs_threads;
+    bool warm_start;                 // Seed compute_flow() with Karp-Sipser
+    KarpSipserSeeder seeder;
+    vector<int> seed_start, seed_requests;  // CSR copy of the pairs for the seeder
+    
+    int source;
+    int sink;
+    int driver_offset;
+    int request_offset;
+    
+    // MAPPED -> SPARSE: copy the mapped pairs into per-driver lists
+    void detach_mapping() {
+        feasible_requests.assign(num_drivers, vector<int>());
+        feasible_costs.assign(num_drivers, vector<int>());
+        for (int i = 0; i < num_drivers; i++) {
+            feasible_requests[i].assign(mapped_requests + mapped_start[i],
+                                        mapped_requests + mapped_start[i + 1]);
+            if (mapped_costs) {
+                feasible_costs[i].assign(mapped_costs + mapped_start[i], mapped_costs + mapped_start[i + 1]);
+            } else {
+                feasible_costs[i].assign(feasible_requests[i].size(), 0);
+            }
+        }
+        model = FeasibilityModel::SPARSE;
+        mapping.reset();
+        mapped_start = mapped_requests = mapped_costs = nullptr;
+    }
+    
+public:
+    RideShareAssignment(int m, int n, FeasibilityModel model = FeasibilityModel::SPARSE) 
+        : num_drivers(m), num_requests(n), model(model), mapped_start(nullptr),
+          mapped_requests(nullptr), mapped_costs(nullptr), num_feasible(0) {
+        driver_capacities.resize(m, 1);
+        request_capacities.resize(n, 1);
+        if (model == FeasibilityModel::MAPPED) {
+            this->model = FeasibilityModel::SPARSE;    // Only load_instance() maps
+        }
+        if (this->model == FeasibilityModel::SPARSE) {
+            feasible_requests.resize(m);
+            feasible_costs.resize(m);
+        } else {
+            feasible_edges.resize(m, vector<bool>(n, false));
+        }
+        
+        // Node numbering: 0=source, 1..m=drivers, m+1..m+n=requests, m+n+1=sink
+        source = 0;
+        driver_offset = 1;
+        request_offset = driver_offset + num_drivers;
+        sink = request_offset + num_requests;
+        
+        flow_graph = nullptr;
+        network_built = false;
+        flow_started = false;
+        engine = FlowEngine::AUTO;
+        bfs_threads = 1;
+        warm_start = true;
+    }
+    
+    ~RideShareAssignment() {
+        if (flow_graph) delete flow_graph;
+    }
+    
+    // Start over with an empty m x n instance (capacities 1), reusing this
+    // object's memory: the per-driver lists, the flow network and the
+    // solver keep their capacity, so a long-lived object re-filled every
+    // dispatch tick allocates little once it has seen its largest instance.
+    // A mapped instance becomes an empty SPARSE one.
+    void reset(int m, int n) {
+        num_drivers = m;
+        num_requests = n;
+        driver_capacities.assign(m, 1);
+        request_capacities.assign(n, 1);
+        if (model == FeasibilityModel::MAPPED) {
+            model = FeasibilityModel::SPARSE;
+            mapping.reset();
+            mapped_start = mapped_requests = mapped_costs = nullptr;
+        }
+        if (model == FeasibilityModel::SPARSE) {
+            feasible_requests.resize(m);
+            feasible_costs.resize(m);
+            for (int i = 0; i < m; i++) {
+                feasible_requests[i].clear();
+                feasible_costs[i].clear();
+            }
+        } else {
+            feasible_edges.resize(m);
+            for (auto& row : feasible_edges) row.assign(n, false);
+            cost_matrix.clear();
+        }
+        num_feasible = 0;
+        
+        request_offset = driver_offset + num_drivers;
+        sink = request_offset + num_requests;
+        network_built = false;
+    }
+    
+    void set_driver_capacity(int driver_id, int capacity) {
+        driver_capacities[driver_id] = capacity;
+    }
+    
+    void set_request_capacity(int request_id, int seats) {
+        request_capacities[request_id] = seats;
+    }
+    
+    // In SPARSE mode duplicate pairs are not filtered; callers add each pair once.
+    // The cost (e.g. deadhead distance, non-negative) is only used by solve_min_cost().
+    // A MAPPED instance is copied to SPARSE lists on its first new pair.
+    void add_feasible_assignment(int driver_id, int request_id, int cost = 0) {
+        if (model == FeasibilityModel::MAPPED) detach_mapping();
+        if (model == FeasibilityModel::SPARSE) {
+            feasible_requests[driver_id].push_back(request_id);
+            feasible_costs[driver_id].push_back(cost);
+            num_feasible++;
+            return;
+        }
+        if (!feasible_edges[driver_id][request_id]) {
+            feasible_edges[driver_id][request_id] = true;
+            num_feasible++;
+        }
+        if (cost != 0 && cost_matrix.empty()) {
+            cost_matrix.assign(num_drivers, vector<int>(num_requests, 0));
+        }
+        if (!cost_matrix.empty()) {
+            cost_matrix[driver_id][request_id] = cost;
+        }
+    }
+    
+    // Bulk ingestion of one driver's adjacency list (and optionally its costs)
+    void add_feasible_assignments(int driver_id, const vector<int>& request_ids,
+                                  const vector<int>* costs = nullptr) {
+        if (model == FeasibilityModel::MAPPED) detach_mapping();
+        if (model == FeasibilityModel::SPARSE) {
+            auto& list = feasible_requests[driver_id];
+            auto& cost_list = feasible_costs[driver_id];
+            list.insert(list.end(), request_ids.begin(), request_ids.end());
+            if (costs) {
+                cost_list.insert(cost_list.end(), costs->begin(), costs->end());
+            } else {
+                cost_list.resize(list.size(), 0);
+            }
+            num_feasible += request_ids.size();
+        } else {
+            for (size_t k = 0; k < request_ids.size(); k++) {
+                add_feasible_assignment(driver_id, request_ids[k], costs ? (*costs)[k] : 0);
+            }
+        }
+    }
+    
+    int num_feasible_assignments() const {
+        return num_feasible;
+    }
+    
+    // Geometric feasibility: driver i can serve request j when their distance
+    // is at most radius. Requests are bucketed in a SpatialGrid, so this costs
+    // O(m + n + E) instead of testing all m * n pairs. Each pair's cost is its
+    // distance rounded to an integer, for solve_min_cost().
+    void add_feasible_within_radius(const vector<double>& driver_x, const vector<double>& driver_y,
+                                    const vector<double>& request_x, const vector<double>& request_y,
+                                    double radius) {
+        SpatialGrid grid(request_x, request_y, radius);
+        vector<int> ids, costs;
+        for (int i = 0; i < num_drivers; i++) {
+            ids.clear();
+            costs.clear();
+            grid.for_each_within(driver_x[i], driver_y[i], radius, [&](int j, double d2) {
+                ids.push_back(j);
+                costs.push_back((int)lround(sqrt(d2)));
+            });
+            add_feasible_assignments(i, ids, &costs);
+        }
+    }
+    
+    void set_flow_engine(FlowEngine e) {
+        engine = e;
+    }
+    
+    // Threads for Dinic's level-graph construction
+    void set_threads(int threads) {
+        bfs_threads = threads;
+    }
+    
+    // Start compute_flow() from a Karp-Sipser initial flow when a Dinic
+    // engine runs (on by default)
+    void set_warm_start(bool on) {
+        warm_start = on;
+    }
+    
+    // Resolve AUTO: Hopcroft-Karp when every capacity is 1, otherwise Dinic
+    FlowEngine selected_engine() const {
+        if (engine != FlowEngine::AUTO) return engine;
+        for (int c : driver_capacities) {
+            if (c != 1) return FlowEngine::DINIC;
+        }
+        for (int c : request_capacities) {
+            if (c != 1) return FlowEngine::DINIC;
+        }
+        return FlowEngine::HOPCROFT_KARP;
+    }
+    
+    // Add the source/driver/request/sink edges to any graph with add_edge().
+    // If pair_handles is given, it receives the handle of every driver->request
+    // edge in for_each_feasible() order. The source edges are added first
+    // and the sink edges last, so with handles 0, 1, 2, ... driver i's is i
+    // and request j's is drivers + pairs + j.
+    template <typename FlowGraph>
+    void add_network_edges(FlowGraph& graph, vector<int>* pair_handles = nullptr) const {
+        // Source to drivers
+        for (int i = 0; i < num_drivers; i++) {
+            graph.add_edge(source, driver_offset + i, driver_capacities[i]);
+        }
+        
+        // Drivers to requests
+        if (pair_handles) {
+            pair_handles->clear();
+            pair_handles->reserve(num_feasible);
+        }
+        for_each_feasible([&](int i, int j) {
+            int handle = graph.add_edge(driver_offset + i, request_offset + j, pair_capacity(i, j));
+            if (pair_handles) pair_handles->push_back(handle);
+        });
+        
+        // Requests to sink
+        for (int j = 0; j < num_requests; j++) {
+            graph.add_edge(request_offset + j, sink, request_capacities[j]);
+        }
+    }
+    
+    int total_nodes() const {
+        return num_drivers + num_requests + 2;
+    }
+    
+    int source_node() const { return source; }
+    int sink_node() const { return sink; }
+    
+    int drivers() const { return num_drivers; }
+    int requests() const { return num_requests; }
+    int driver_capacity(int driver_id) const { return driver_capacities[driver_id]; }
+    int request_capacity(int request_id) const { return request_capacities[request_id]; }
+    
+    // Seats driver i can take of request j
+    int pair_capacity(int driver_id, int request_id) const {
+        return min(driver_capacities[driver_id], request_capacities[request_id]);
+    }
+    
+    // Visit feasible pairs driver by driver, requests in insertion order
+    // (SPARSE) or ascending order (DENSE)
+    template <typename Visitor>
+    void for_each_feasible(Visitor visit) const {
+        for (int i = 0; i < num_drivers; i++) {
+            if (model == FeasibilityModel::SPARSE) {
+                for (int j : feasible_requests[i]) visit(i, j);
+            } else if (model == FeasibilityModel::MAPPED) {
+                for (int k = mapped_start[i]; k < mapped_start[i + 1]; k++) visit(i, mapped_requests[k]);
+            } else {
+                for (int j = 0; j < num_requests; j++) {
+                    if (feasible_edges[i][j]) visit(i, j);
+                }
+            }
+        }
+    }
+    
+    // Same order as for_each_feasible(), also passing the pair's cost
+    template <typename Visitor>
+    void for_each_feasible_cost(Visitor visit) const {
+        for (int i = 0; i < num_drivers; i++) {
+            if (model == FeasibilityModel::SPARSE) {
+                for (size_t k = 0; k < feasible_requests[i].size(); k++) {
+                    visit(i, feasible_requests[i][k], feasible_costs[i][k]);
+                }
+            } else if (model == FeasibilityModel::MAPPED) {
+                for (int k = mapped_start[i]; k < mapped_start[i + 1]; k++) {
+                    visit(i, mapped_requests[k], mapped_costs ? mapped_costs[k] : 0);
+                }
+            } else {
+                for (int j = 0; j < num_requests; j++) {
+                    if (feasible_edges[i][j]) visit(i, j, cost_matrix.empty() ? 0 : cost_matrix[i][j]);
+                }
+            }
+        }
+    }
+    
+    // Write the instance in the binary format (CSR pairs in
+    // for_each_feasible() order). False on I/O errors.
+    bool save_instance(const string& path) const {
+        vector<int> start(num_drivers + 1, 0), requests, costs;
+        requests.reserve(num_feasible);
+        costs.reserve(num_feasible);
+        bool any_cost = false;
+        for_each_feasible_cost([&](int i, int j, int cost) {
+            start[i + 1]++;
+            requests.push_back(j);
+            costs.push_back(cost);
+            any_cost = any_cost || cost != 0;
+        });
+        for (int i = 0; i < num_drivers; i++) start[i + 1] += start[i];
+        bool any_seats = false;
+        for (int c : request_capacities) any_seats = any_seats || c != 1;
+        
+        uint64_t counts[4] = {(uint64_t)num_drivers, (uint64_t)num_requests, requests.size(), 0};
+        vector<InstanceSection> sections = {
+            {driver_capacities.data(), driver_capacities.size() * sizeof(int)},
+            {start.data(), start.size() * sizeof(int)},
+            {requests.data(), requests.size() * sizeof(int)},
+            {costs.data(), any_cost ? costs.size() * sizeof(int) : 0},
+            {request_capacities.data(), any_seats ? request_capacities.size() * sizeof(int) : 0}};
+        return write_instance_file(path, RIDESHARE_MAGIC, counts, sections);
+    }
+    
+    // Map an instance file written by save_instance(). The pairs stay in the
+    // mapping (MAPPED model); only the capacities are copied, so they can
+    // still be changed. The offsets and ids are checked in one pass.
+    // nullptr (with a message on cerr) if the file is unusable.
+    static RideShareAssignment* load_instance(const string& path) {
+        RideShareAssignment* problem = new RideShareAssignment(0, 0);
+        if (!load_instance(path, *problem)) {
+            delete problem;
+            return nullptr;
+        }
+        return problem;
+    }
+    
+    // Same, into an existing object: its flow network and solver are kept
+    // for reuse (see reset()). False, with the object unchanged, on errors.
+    static bool load_instance(const string& path, RideShareAssignment& problem) {
+        shared_ptr<MappedFile> file = make_shared<MappedFile>();
+        string error;
+        const InstanceHeader* header = nullptr;
+        if (!file->open(path)) {
+            error = "cannot open or map the file";
+        } else {
+            header = check_instance_header(*file, RIDESHARE_MAGIC, error);
+        }
+        
+        const int *capacities = nullptr, *start = nullptr, *requests = nullptr, *costs = nullptr;
+        const int* seats = nullptr;
+        uint64_t m = 0, n = 0, pairs = 0;
+        if (header) {
+            m = header->counts[0];
+            n = header->counts[1];
+            pairs = header->counts[2];
+            if (m + n + 2 > (uint64_t)INT_MAX || pairs > (uint64_t)INT_MAX) {
+                error = "instance too large for 32-bit ids";
+            } else if (!instance_section(*file, header, 0, m, capacities) ||
+                       !instance_section(*file, header, 1, m + 1, start) ||
+                       !instance_section(*file, header, 2, pairs, requests) ||
+                       (header->section_bytes[3] != 0 &&
+                        !instance_section(*file, header, 3, pairs, costs)) ||
+                       (header->section_bytes[4] != 0 &&
+                        !instance_section(*file, header, 4, n, seats))) {
+                error = "section sizes do not match the header counts";
+            } else if (start[0] != 0 || start[m] != (int)pairs) {
+                error = "CSR offsets do not span the pairs";
+            } else {
+                for (uint64_t i = 0; i < m && error.empty(); i++) {
+                    if (start[i] > start[i + 1]) error = "CSR offsets are not sorted";
+                }
+                for (uint64_t k = 0; k < pairs && error.empty(); k++) {
+                    if (requests[k] < 0 || requests[k] >= (int)n) error = "request id out of range";
+                }
+            }
+        }
+        if (!error.empty()) {
+            cerr << "Error: cannot load " << path << ": " << error << endl;
+            return false;
+        }
+        
+        // No per-driver lists: a mapped instance reads its pairs in place
+        problem.reset(0, 0);
+        problem.num_drivers = m;
+        problem.num_requests = n;
+        problem.request_offset = problem.driver_offset + m;
+        problem.sink = problem.request_offset + n;
+        problem.model = FeasibilityModel::MAPPED;
+        problem.driver_capacities.assign(capacities, capacities + m);
+        if (seats) {
+            problem.request_capacities.assign(seats, seats + n);
+        } else {
+            problem.request_capacities.assign(n, 1);
+        }
+        problem.mapping = file;
+        problem.mapped_start = start;
+        problem.mapped_requests = requests;
+        problem.mapped_costs = costs;
+        problem.num_feasible = pairs;
+        return true;
+    }
+    
+    void build_flow_network() {
+        if (flow_graph) {
+            flow_graph->reset(total_nodes());
+        } else {
+            flow_graph = new MaxFlow(total_nodes());
+        }
+        add_network_edges(*flow_graph, &pair_edges);
+        flow_graph->freeze();
+        flow_graph->set_threads(bfs_threads);
+        network_built = true;
+        flow_started = false;
+    }
+    
+    // Write the Karp-Sipser initial flow (see KarpSipserSeeder) into a
+    // graph that add_network_edges() filled and that carries no flow yet;
+    // pair_handles are the handles it returned. Returns the units placed.
+    int seed_flow(MaxFlow& graph, const vector<int>& pair_handles) {
+        const int *start, *requests;
+        if (model == FeasibilityModel::MAPPED) {
+            start = mapped_start;
+            requests = mapped_requests;
+        } else {
+            seed_start.assign(num_drivers + 1, 0);
+            seed_requests.clear();
+            seed_requests.reserve(num_feasible);
+            for_each_feasible([&](int i, int j) {
+                seed_start[i + 1]++;
+                seed_requests.push_back(j);
+            });
+            for (int i = 0; i < num_drivers; i++) seed_start[i + 1] += seed_start[i];
+            start = seed_start.data();
+            requests = seed_requests.data();
+        }
+        
+        int seeded = seeder.run(driver_capacities, request_capacities, start, requests);
+        int sink_handles = num_drivers + num_feasible;
+        for (int i = 0; i < num_drivers; i++) {
+            int driver_flow = 0;
+            for (int k = start[i]; k < start[i + 1]; k++) {
+                int f = seeder.pair_flow(k);
+                if (f == 0) continue;
+                graph.push_edge(pair_handles[k], f);
+                graph.push_edge(sink_handles + requests[k], f);
+                driver_flow += f;
+            }
+            if (driver_flow > 0) graph.push_edge(i, driver_flow);
+        }
+        return seeded;
+    }
+    
+    // Counters of the last seed_flow()
+    const KarpSipserSeeder::Stats& last_seed_stats() const {
+        return seeder.last_stats();
+    }
+    
+    // The first call after a build (here or by the caller) seeds the empty
+    // network. Hopcroft-Karp's first phase is already a greedy matching, and
+    // seeding did not pay off for it (see --benchmark-warm-start), so only
+    // the Dinic engines start from the seeded flow
+    int compute_flow() {
+        FlowEngine e = selected_engine();
+        int seeded = 0;
+        if (!network_built) {
+            build_flow_network();
+        }
+        if (!flow_started && warm_start && (e == FlowEngine::DINIC || e == FlowEngine::DINIC_SCALING)) {
+            seeded = seed_flow(*flow_graph, pair_edges);
+        }
+        flow_started = true;
+        if (!solver || solver_engine != e) {
+            solver = make_flow_solver(e);
+            solver_engine = e;
+        }
+        return seeded + solver->solve(*flow_graph, source, sink);
+    }
+    
+    // Read the assignments off the residual graph in one pass over the
+    // driver->request edges: O(E)
+    vector<pair<int, int>> extract_assignments() {
+        vector<pair<int, int>> assignments;
+        int k = 0;
+        for_each_feasible([&](int i, int j) {
+            if (flow_graph->edge_flow(pair_edges[k++]) > 0) {
+                assignments.push_back({i, j});
+            }
+        });
+        return assignments;
+    }
+    
+    pair<int, vector<pair<int, int>>> solve() {
+        int max_flow_value = compute_flow();
+        return {max_flow_value, extract_assignments()};
+    }
+    
+    struct MinCostResult {
+        int flow_value;               // Seats served
+        long long total_cost;
+        vector<pair<int, int>> assignments;
+        long long refines;            // Cost-scaling phases
+        long long relabels;           // Price decreases over all phases
+        long long price_updates;      // Global price updates
+    };
+    
+    // Maximum number of matches, and among those the one with least total
+    // cost (per seat). A max flow on the same network gives the number of
+    // seats that can be served; the min-cost flow then routes exactly that
+    // many from the source, so no big-M "unassigned" edges are needed.
+    MinCostResult solve_min_cost() {
+        MaxFlow counting(total_nodes());
+        add_network_edges(counting);
+        counting.freeze();
+        int seats_served = make_flow_solver(selected_engine())->solve(counting, source, sink);
+        
+        MinCostFlow graph(total_nodes());
+        for (int i = 0; i < num_drivers; i++) {
+            graph.add_edge(source, driver_offset + i, driver_capacities[i], 0);
+        }
+        vector<int> handles;
+        handles.reserve(num_feasible);
+        for_each_feasible_cost([&](int i, int j, int cost) {
+            handles.push_back(graph.add_edge(driver_offset + i, request_offset + j, pair_capacity(i, j), cost));
+        });
+        for (int j = 0; j < num_requests; j++) {
+            graph.add_edge(request_offset + j, sink, request_capacities[j], 0);
+        }
+        graph.set_supply(source, seats_served);
+        
+        graph.solve(sink);
+        
+        vector<pair<int, int>> assignments;
+        long long total_cost = 0;
+        int seats = 0, k = 0;
+        for_each_feasible_cost([&](int i, int j, int cost) {
+            int f = graph.edge_flow(handles[k++]);
+            if (f > 0) {
+                assignments.push_back({i, j});
+                total_cost += (long long)cost * f;
+                seats += f;
+            }
+        });
+        return {seats, total_cost, assignments,
+                graph.refine_count(), graph.relabel_count(), graph.price_update_count()};
+    }
+    
+    void print_stats() {
+        int num_edges = num_feasible;
+        
+        int total_nodes = num_drivers + num_requests + 2;
+        int total_edges = num_drivers + num_edges + num_requests;
+        
+        cout << "Flow Network Statistics:" << '\n';
+        cout << "  Nodes: " << total_nodes << '\n';
+        cout << "  Edges: " << total_edges << '\n';
+        cout << "  Drivers: " << num_drivers << '\n';
+        cout << "  Requests: " << num_requests << '\n';
+        cout << "  Feasible edges: " << num_edges << '\n';
+    }
+};
+
+// Incremental re-matching for a changing driver/request graph.
+// Drivers keep their capacities; every request takes exactly one seat
+// (instances with multi-seat requests are rejected).
+//
+// Keeps the current maximum flow in implicit residual form: request_driver
+// holds the driver->request flow, driver_load the source->driver flow and
+// an assigned request uses its request->sink edge. Every change is repaired
+// with at most a few augmenting-path searches that only explore the part of
+// the graph reachable from the changed driver or request, instead of
+// rebuilding the network and re-running max flow.
+class IncrementalRideShare {
+private:
+    vector<int> driver_cap, driver_load;
+    vector<char> driver_alive, request_alive;
+    vector<vector<int>> driver_adj;       // Feasible requests of each driver
+    vector<vector<int>> request_adj;      // Feasible drivers of each request
+    vector<vector<int>> driver_assigned;  // Requests carrying flow from each driver
+    vector<int> request_driver;           // Assigned driver, or -1
+    int matched;
+    
+    // Search state, reset in O(1) by bumping the epoch
+    vector<int> driver_seen, request_seen;
+    vector<int> via, prev;
+    vector<int> search_queue;
+    int epoch;
+    int searches;
+    
+    static void erase_value(vector<int>& list, int value) {
+        auto it = find(list.begin(), list.end(), value);
+        if (it != list.end()) {
+            *it = list.back();
+            list.pop_back();
+        }
+    }
+    
+    void unassign(int r) {
+        int d = request_driver[r];
+        if (d < 0) return;
+        driver_load[d]--;
+        erase_value(driver_assigned[d], r);
+        request_driver[r] = -1;
+        matched--;
+    }
+    
+    // Move request r to driver d (r may currently be free)
+    void assign(int r, int d) {
+        if (request_driver[r] >= 0) {
+            unassign(r);
+        }
+        request_driver[r] = d;
+        driver_load[d]++;
+        driver_assigned[d].push_back(r);
+        matched++;
+    }
+    
+    void new_search() {
+        if (++epoch == INF) {
+            fill(driver_seen.begin(), driver_seen.end(), 0);
+            fill(request_seen.begin(), request_seen.end(), 0);
+            epoch = 1;
+        }
+        searches++;
+        search_queue.clear();
+    }
+    
+    // Let driver d0 take one more request: follow alternating paths
+    // d0 -> y (taken from driver e) -> e -> y' ... until a free request.
+    // via/prev are indexed by driver: via[e] = request e gives up,
+    // prev[e] = driver that takes it.
+    bool augment_from_driver(int d0) {
+        new_search();
+        driver_seen[d0] = epoch;
+        search_queue.push_back(d0);
+        
+        for (size_t head = 0; head < search_queue.size(); head++) {
+            int u = search_queue[head];
+            for (int y : driver_adj[u]) {
+                if (request_driver[y] == u || request_seen[y] == epoch) continue;
+                request_seen[y] = epoch;
+                
+                int e = request_driver[y];
+                if (e < 0) {
+                    // Shift the chain back towards d0
+                    assign(y, u);
+                    for (int cur = u; cur != d0; cur = prev[cur]) {
+                        assign(via[cur], prev[cur]);
+                    }
+                    return true;
+                }
+                if (driver_seen[e] != epoch) {
+                    driver_seen[e] = epoch;
+                    via[e] = y;
+                    prev[e] = u;
+                    search_queue.push_back(e);
+                }
+            }
+        }
+        return false;
+    }
+    
+    // Move one of the source requests to another driver: follow alternating
+    // paths x -> e (which drops request x') -> x' ... until a driver with
+    // spare capacity. Drivers marked with skip_driver are never used.
+    // via/prev are indexed by request (search_queue holds requests here):
+    // via[x'] = driver that drops x', prev[x'] = request that driver takes.
+    bool augment_from_requests(const vector<int>& sources, int skip_driver) {
+        new_search();
+        if (skip_driver >= 0) driver_seen[skip_driver] = epoch;
+        for (int x : sources) {
+            request_seen[x] = epoch;
+            prev[x] = -1;
+            search_queue.push_back(x);
+        }
+        
+        for (size_t head = 0; head < search_queue.size(); head++) {
+            int x = search_queue[head];
+            for (int e : request_adj[x]) {
+                if (e == request_driver[x] || driver_seen[e] == epoch) continue;
+                driver_seen[e] = epoch;
+                
+                if (driver_load[e] < driver_cap[e]) {
+                    assign(x, e);
+                    for (int cur = x; prev[cur] >= 0; cur = prev[cur]) {
+                        assign(prev[cur], via[cur]);
+                    }
+                    return true;
+                }
+                for (int z : driver_assigned[e]) {
+                    if (request_seen[z] != epoch) {
+                        request_seen[z] = epoch;
+                        via[z] = e;
+                        prev[z] = x;
+                        search_queue.push_back(z);
+                    }
+                }
+            }
+        }
+        return false;
+    }
+    
+    void grow_search_state() {
+        int size = max(driver_cap.size(), request_driver.size());
+        driver_seen.resize(driver_cap.size(), 0);
+        request_seen.resize(request_driver.size(), 0);
+        via.resize(size);
+        prev.resize(size);
+    }
+    
+public:
+    IncrementalRideShare() : matched(0), epoch(0), searches(0) {}
+    
+    // Start from a solved instance: copies the graph and its maximum flow.
+    // Requests are single-seat here (one driver each), so an instance with
+    // any request capacity other than 1 throws invalid_argument.
+    explicit IncrementalRideShare(RideShareAssignment& problem) : IncrementalRideShare() {
+        for (int j = 0; j < problem.requests(); j++) {
+            if (problem.request_capacity(j) != 1) {
+                throw invalid_argument("IncrementalRideShare: request " + to_string(j) + " needs " +
+                                       to_string(problem.request_capacity(j)) + " seats; only 1 is supported");
+            }
+        }
+        for (int i = 0; i < problem.drivers(); i++) add_driver(problem.driver_capacity(i));
+        for (int j = 0; j < problem.requests(); j++) add_request();
+        problem.for_each_feasible([&](int i, int j) {
+            driver_adj[i].push_back(j);
+            request_adj[j].push_back(i);
+        });
+        for (auto& p : problem.solve().second) {
+            assign(p.second, p.first);
+        }
+    }
+    
+    int add_driver(int capacity) {
+        driver_cap.push_back(capacity);
+        driver_load.push_back(0);
+        driver_alive.push_back(1);
+        driver_adj.emplace_back();
+        driver_assigned.emplace_back();
+        grow_search_state();
+        return (int)driver_cap.size() - 1;
+    }
+    
+    int add_request() {
+        request_driver.push_back(-1);
+        request_alive.push_back(1);
+        request_adj.emplace_back();
+        grow_search_state();
+        return (int)request_driver.size() - 1;
+    }
+    
+    // Add a driver together with its feasible requests, then fill its
+    // capacity with one search per unit (stopping at the first failure)
+    int add_driver(int capacity, const vector<int>& requests) {
+        int d = add_driver(capacity);
+        for (int r : requests) {
+            if (!request_alive[r]) continue;
+            driver_adj[d].push_back(r);
+            request_adj[r].push_back(d);
+        }
+        while (driver_load[d] < driver_cap[d] && augment_from_driver(d)) {}
+        return d;
+    }
+    
+    // Add a request together with its feasible drivers and match it with a
+    // single search
+    int add_request(const vector<int>& drivers) {
+        int r = add_request();
+        for (int d : drivers) {
+            if (!driver_alive[d]) continue;
+            driver_adj[d].push_back(r);
+            request_adj[r].push_back(d);
+        }
+        augment_from_requests({r}, -1);
+        return r;
+    }
+    
+    void add_feasible_edge(int d, int r) {
+        if (!driver_alive[d] || !request_alive[r]) return;
+        driver_adj[d].push_back(r);
+        request_adj[r].push_back(d);
+        
+        // Any new augmenting path must use d -> r
+        bool spare = driver_load[d] < driver_cap[d];
+        if (spare && request_driver[r] < 0) {
+            assign(r, d);
+        } else if (spare) {
+            augment_from_driver(d);
+        } else if (request_driver[r] < 0) {
+            augment_from_requests({r}, -1);
+        } else if (augment_from_requests(driver_assigned[d], d)) {
+            // d now has spare capacity at the same flow value
+            augment_from_driver(d);
+        }
+    }
+    
+    void remove_feasible_edge(int d, int r) {
+        erase_value(driver_adj[d], r);
+        erase_value(request_adj[r], d);
+        if (request_driver[r] != d) return;
+        
+        // Repair along a path starting at d or ending at r
+        unassign(r);
+        if (!augment_from_driver(d)) {
+            augment_from_requests({r}, -1);
+        }
+    }
+    
+    void remove_driver(int d) {
+        vector<int> freed = driver_assigned[d];
+        for (int r : freed) unassign(r);
+        for (int r : driver_adj[d]) erase_value(request_adj[r], d);
+        driver_adj[d].clear();
+        driver_alive[d] = 0;
+        driver_cap[d] = 0;
+        
+        for (int r : freed) {
+            augment_from_requests({r}, -1);
+        }
+    }
+    
+    void cancel_request(int r) {
+        int d = request_driver[r];
+        unassign(r);
+        for (int e : request_adj[r]) erase_value(driver_adj[e], r);
+        request_adj[r].clear();
+        request_alive[r] = 0;
+        
+        if (d >= 0) {
+            augment_from_driver(d);
+        }
+    }
+    
+    int flow_value() const { return matched; }
+    
+    // Augmenting-path searches run since construction
+    int search_count() const { return searches; }
+    
+    vector<pair<int, int>> assignments() const {
+        vector<pair<int, int>> result;
+        for (int d = 0; d < (int)driver_assigned.size(); d++) {
+            for (int r : driver_assigned[d]) result.push_back({d, r});
+        }
+        return result;
+    }
+    
+    // Rebuild the current graph as a static instance (removed drivers keep
+    // their ids with capacity 0, cancelled requests keep ids with no edges)
+    RideShareAssignment* snapshot() const {
+        RideShareAssignment* problem = new RideShareAssignment(driver_cap.size(), request_driver.size());
+        for (int d = 0; d < (int)driver_cap.size(); d++) {
+            problem->set_driver_capacity(d, driver_cap[d]);
+            problem->add_feasible_assignments(d, driver_adj[d]);
+        }
+        return problem;
+    }
+};
+
+// Capacities drawn by the generators: driver seats and request party
+// sizes, each uniform in [min, max]
+struct CapacityProfile {
+    const char* name;
+    int driver_min, driver_max;
+    int seats_min, seats_max;
+};
+
+const CapacityProfile UNIT_CAPACITIES = {"unit", 1, 1, 1, 1};
+
+// Draw every driver's capacity and every request's seats from profile.
+// Fixed ranges draw nothing, so unit instances keep their random streams.
+void assign_capacities(RideShareAssignment& problem, const CapacityProfile& profile, mt19937& rng) {
+    uniform_int_distribution<int> driver_cap(profile.driver_min, profile.driver_max);
+    uniform_int_distribution<int> seats(profile.seats_min, profile.seats_max);
+    for (int i = 0; i < problem.drivers(); i++) {
+        problem.set_driver_capacity(i, profile.driver_min == profile.driver_max ? profile.driver_min
+                                                                                : driver_cap(rng));
+    }
+    for (int j = 0; j < problem.requests(); j++) {
+        problem.set_request_capacity(j, profile.seats_min == profile.seats_max ? profile.seats_min
+                                                                               : seats(rng));
+    }
+}
+
+// Generate random instance
+RideShareAssignment* generate_random_instance(int num_drivers, int num_requests, 
+                                              double edge_probability, 
+                                              mt19937& rng,
+                                              const CapacityProfile& capacities = UNIT_CAPACITIES) {
+    RideShareAssignment* problem = new RideShareAssignment(num_drivers, num_requests);
+    assign_capacities(*problem, capacities, rng);
+    
+    // Generate feasible edges randomly
+    uniform_real_distribution<double> dist(0.0, 1.0);
+    for (int i = 0; i < num_drivers; i++) {
+        for (int j = 0; j < num_requests; j++) {
+            if (dist(rng) < edge_probability) {
+                problem->add_feasible_assignment(i, j);
+            }
+        }
+    }
+    
+    return problem;
+}
+
+// Sparse random instance with costs: each driver gets `degree` random
+// requests with a cost drawn from [1, max_cost]. O(m * degree) to build.
+RideShareAssignment* generate_sparse_cost_instance(int num_drivers, int num_requests,
+                                                   int degree, int max_cost,
+                                                   mt19937& rng) {
+    RideShareAssignment* problem = new RideShareAssignment(num_drivers, num_requests);
+    uniform_int_distribution<int> pick_request(0, num_requests - 1);
+    uniform_int_distribution<int> pick_cost(1, max_cost);
+    
+    vector<int> requests(degree), costs(degree);
+    for (int i = 0; i < num_drivers; i++) {
+        for (int k = 0; k < degree; k++) {
+            requests[k] = pick_request(rng);
+            costs[k] = pick_cost(rng);
+        }
+        problem->add_feasible_assignments(i, requests, &costs);
+    }
+    
+    return problem;
+}
+
+// Uniform random points in [0, side)^2
+void generate_points(int count, double side, mt19937& rng,
+                     vector<double>& xs, vector<double>& ys) {
+    uniform_real_distribution<double> coord(0.0, side);
+    xs.resize(count);
+    ys.resize(count);
+    for (int i = 0; i < count; i++) {
+        xs[i] = coord(rng);
+        ys[i] = coord(rng);
+    }
+}
+
+// Geometric instance: drivers and requests uniform in a square of side
+// sqrt(num_requests) (one request per unit area); a driver can serve the
+// requests within `radius`, so the expected degree is about pi * radius^2.
+// O(m + n + E) to build.
+RideShareAssignment* generate_geometric_instance(int num_drivers, int num_requests,
+                                                 double radius, mt19937& rng,
+                                                 const CapacityProfile& capacities = UNIT_CAPACITIES) {
+    double side = sqrt((double)max(num_requests, 1));
+    vector<double> driver_x, driver_y, request_x, request_y;
+    generate_points(num_drivers, side, rng, driver_x, driver_y);
+    generate_points(num_requests, side, rng, request_x, request_y);
+    
+    RideShareAssignment* problem = new RideShareAssignment(num_drivers, num_requests);
+    problem->add_feasible_within_radius(driver_x, driver_y, request_x, request_y, radius);
+    assign_capacities(*problem, capacities, rng);
+    return problem;
+}
+
+// Text instance: one "driver,request[,cost]" line per feasible pair, with
+// an optional header line. Drivers and requests are numbered from 0 and
+// the counts are the largest ids + 1; every driver has capacity 1. The
+// instance replaces problem's contents through reset(), so a reused
+// object keeps its memory. False (message on cerr) on errors.
+bool read_csv_instance(const string& path, RideShareAssignment& problem) {
+    ifstream in(path);
+    if (!in) {
+        cerr << "Error: cannot open " << path << endl;
+        return false;
+    }
+    vector<int> drivers, requests, costs;
+    string line;
+    int line_number = 0;
+    while (getline(in, line)) {
+        line_number++;
+        if (line.empty() || line[0] == '\r') continue;
+        const char* p = line.c_str();
+        char* end;
+        long fields[3] = {0, 0, 0};
+        int count = 0;
+        while (count < 3) {
+            fields[count] = strtol(p, &end, 10);
+            if (end == p) break;
+            count++;
+            p = end;
+            if (*p != ',') break;
+            p++;
+        }
+        if (count < 2 || fields[0] < 0 || fields[1] < 0 || fields[0] >= INT_MAX || fields[1] >= INT_MAX) {
+            if (line_number == 1) continue;    // Header
+            cerr << "Error: " << path << ":" << line_number << ": expected driver,request[,cost]" << endl;
+            return false;
+        }
+        drivers.push_back(fields[0]);
+        requests.push_back(fields[1]);
+        costs.push_back(fields[2]);
+    }
+    
+    int m = 0, n = 0;
+    for (size_t k = 0; k < drivers.size(); k++) {
+        m = max(m, drivers[k] + 1);
+        n = max(n, requests[k] + 1);
+    }
+    problem.reset(m, n);
+    for (size_t k = 0; k < drivers.size(); k++) {
+        problem.add_feasible_assignment(drivers[k], requests[k], costs[k]);
+    }
+    return true;
+}
+
+RideShareAssignment* read_csv_instance(const string& path) {
+    RideShareAssignment* problem = new RideShareAssignment(0, 0);
+    if (!read_csv_instance(path, *problem)) {
+        delete problem;
+        return nullptr;
+    }
+    return problem;
+}
+
+void write_csv_instance(const RideShareAssignment& problem, const string& path) {
+    ofstream out(path);
+    out << "driver,request,cost\n";
+    problem.for_each_feasible_cost([&](int i, int j, int cost) {
+        out << i << "," << j << "," << cost << "\n";
+    });
+}
+
+// CSV -> binary instance file. Returns false if either side fails.
+bool convert_csv_instance(const string& csv_path, const string& binary_path) {
+    RideShareAssignment* problem = read_csv_instance(csv_path);
+    if (!problem) return false;
+    bool ok = problem->save_instance(binary_path);
+    if (ok) {
+        cout << "Wrote " << problem->drivers() << " drivers, " << problem->requests()
+             << " requests, " << problem->num_feasible_assignments() << " pairs to "
+             << binary_path << '\n';
+    } else {
+        cerr << "Error: cannot write " << binary_path << endl;
+    }
+    delete problem;
+    return ok;
+}
+
+// Benchmark runtime
+void benchmark_runtime(vector<int>& sizes, double edge_probability, 
+                      int trials, const string& output_file) {
+    ResultWriter out(output_file, {"size", "runtime_ms", "flow_value", "num_edges", "flow_ms",
+                                   "extract_ms", "dinic_ms", "hopcroft_karp_ms",
+                                   "push_relabel_ms", "dinic_phases", "dinic_aug_per_phase",
+                                   "dinic_bfs_arcs", "dinic_dfs_advances", "dinic_dfs_retreats",
+                                   "dinic_dfs_skipped", "dinic_bfs_ms", "dinic_augment_ms"},
+                     result_formats);
+    
+    mt19937 rng(benchmark_seed);
+    
+    for (int size : sizes) {
+        cout << "Benchmarking size " << size << "..." << endl;
+        
+        for (int trial = 0; trial < trials; trial++) {
+            auto problem = generate_random_instance(size, size, edge_probability, rng);
+            // runtime_ms is Dinic's (the plot and README analyse it as such);
+            // AUTO would pick Hopcroft-Karp here, which has its own column
+            problem->set_flow_engine(FlowEngine::DINIC);
+            
+            auto start = high_resolution_clock::now();
+            int flow_value = problem->compute_flow();
+            auto mid = high_resolution_clock::now();
+            auto assignments = problem->extract_assignments();
+            auto end = high_resolution_clock::now();
+            
+            auto duration = duration_cast<microseconds>(end - start);
+            double runtime_ms = duration.count() / 1000.0;
+            double flow_ms = duration_cast<microseconds>(mid - start).count() / 1000.0;
+            double extract_ms = duration_cast<microseconds>(end - mid).count() / 1000.0;
+            
+            out << size << runtime_ms 
+                << flow_value << assignments.size()
+                << flow_ms << extract_ms;
+            
+            // Every engine on a fresh copy of the same network
+            FlowEngine engines[] = {FlowEngine::DINIC, FlowEngine::HOPCROFT_KARP,
+                                    FlowEngine::PUSH_RELABEL};
+            FlowStats dinic_stats;
+            for (FlowEngine e : engines) {
+                MaxFlow graph(problem->total_nodes());
+                problem->add_network_edges(graph);
+                graph.freeze();
+                auto solver = make_flow_solver(e);
+                
+                auto engine_start = high_resolution_clock::now();
+                int engine_flow = solver->solve(graph, problem->source_node(), problem->sink_node());
+                auto engine_end = high_resolution_clock::now();
+                
+                if (engine_flow != flow_value) {
+                    cerr << "Error: " << solver->name() << " found flow " << engine_flow
+                         << ", expected " << flow_value << endl;
+                }
+                if (e == FlowEngine::DINIC) dinic_stats = graph.last_stats();
+                out << duration_cast<microseconds>(engine_end - engine_start).count() / 1000.0;
+            }
+            out << dinic_stats.phases << dinic_stats.augmentations_per_phase();
+            if (instrumented) {
+                out << dinic_stats.bfs_arcs_scanned << dinic_stats.dfs_advances
+                    << dinic_stats.dfs_retreats << dinic_stats.dfs_arcs_skipped
+                    << dinic_stats.bfs_ms << dinic_stats.augment_ms;
+            } else {
+                out.skip(6);
+            }
+            out.end_row();
+            
+            delete problem;
+        }
+    }
+    
+    out.close();
+    cout << "Results saved to " << output_file << '\n';
+}
+
+// Compare the CSR residual graph against the adjacency-list layout on the
+// same instances. Total timings include building the graph; the *_solve_ms
+// columns time max_flow alone.
+void benchmark_layout(vector<int>& sizes, double edge_probability,
+                      int trials, const string& output_file) {
+    ResultWriter out(output_file, {"size", "adjlist_ms", "csr_ms", "speedup",
+                                   "adjlist_solve_ms", "csr_solve_ms", "flow_value"},
+                     result_formats);
+    
+    mt19937 rng(benchmark_seed);
+    
+    for (int size : sizes) {
+        cout << "Benchmarking layout at size " << size << "..." << endl;
+        
+        double adjlist_total = 0, csr_total = 0;
+        for (int trial = 0; trial < trials; trial++) {
+            auto problem = generate_random_instance(size, size, edge_probability, rng);
+            int s = problem->source_node(), t = problem->sink_node();
+            
+            auto start = high_resolution_clock::now();
+            AdjListMaxFlow adjlist(problem->total_nodes());
+            problem->add_network_edges(adjlist);
+            auto adjlist_built = high_resolution_clock::now();
+            int adjlist_flow = adjlist.max_flow(s, t);
+            auto mid = high_resolution_clock::now();
+            MaxFlow csr(problem->total_nodes());
+            problem->add_network_edges(csr);
+            csr.freeze();
+            auto csr_built = high_resolution_clock::now();
+            int csr_flow = csr.max_flow(s, t);
+            auto end = high_resolution_clock::now();
+            
+            if (adjlist_flow != csr_flow) {
+                cerr << "Error: layouts disagree on flow value ("
+                     << adjlist_flow << " vs " << csr_flow << ")" << endl;
+            }
+            
+            double adjlist_ms = duration_cast<microseconds>(mid - start).count() / 1000.0;
+            double csr_ms = duration_cast<microseconds>(end - mid).count() / 1000.0;
+            double adjlist_solve_ms = duration_cast<microseconds>(mid - adjlist_built).count() / 1000.0;
+            double csr_solve_ms = duration_cast<microseconds>(end - csr_built).count() / 1000.0;
+            adjlist_total += adjlist_ms;
+            csr_total += csr_ms;
+            
+            out << size << adjlist_ms << csr_ms
+                << (csr_ms > 0 ? adjlist_ms / csr_ms : 0.0)
+                << adjlist_solve_ms << csr_solve_ms << csr_flow;
+            out.end_row();
+            
+            delete problem;
+        }
+        
+        cout << "  Mean speedup (adjacency list / CSR): "
+             << (csr_total > 0 ? adjlist_total / csr_total : 0.0) << "x" << '\n';
+    }
+    
+    out.close();
+    cout << "Results saved to " << output_file << '\n';
+}
+
+// Apply random arrivals/cancellations each tick and compare the incremental
+// repair time against rebuilding and re-solving the whole instance.
+void benchmark_incremental(int size, double edge_probability, int ticks,
+                           const vector<int>& changes_per_tick, const string& output_file) {
+    ResultWriter out(output_file, {"size", "changes", "tick", "incremental_ms", "full_ms",
+                                   "flow_value", "searches"}, result_formats);
+    
+    mt19937 rng(benchmark_seed);
+    int degree = max(1, (int)(edge_probability * size));
+    
+    for (int changes : changes_per_tick) {
+        cout << "Benchmarking " << changes << " changes per tick..." << endl;
+        
+        auto problem = generate_random_instance(size, size, edge_probability, rng);
+        IncrementalRideShare live(*problem);
+        delete problem;
+        int num_drivers = size, num_requests = size;
+        
+        for (int tick = 0; tick < ticks; tick++) {
+            int searches_before = live.search_count();
+            auto start = high_resolution_clock::now();
+            for (int c = 0; c < changes; c++) {
+                switch (rng() % 4) {
+                    case 0: {
+                        vector<int> drivers(degree);
+                        for (int& d : drivers) d = rng() % num_drivers;
+                        live.add_request(drivers);
+                        num_requests++;
+                        break;
+                    }
+                    case 1:
+                        live.cancel_request(rng() % num_requests);
+                        break;
+                    case 2: {
+                        vector<int> requests(degree);
+                        for (int& r : requests) r = rng() % num_requests;
+                        live.add_driver(1, requests);
+                        num_drivers++;
+                        break;
+                    }
+                    default:
+                        live.remove_driver(rng() % num_drivers);
+                        break;
+                }
+            }
+            auto mid = high_resolution_clock::now();
+            
+            auto snapshot = live.snapshot();
+            int full_flow = snapshot->solve().first;
+            auto end = high_resolution_clock::now();
+            delete snapshot;
+            
+            if (full_flow != live.flow_value()) {
+                cerr << "Error: incremental flow " << live.flow_value()
+                     << " differs from full solve " << full_flow << endl;
+            }
+            
+            out << size << changes << tick
+                << duration_cast<microseconds>(mid - start).count() / 1000.0
+                << duration_cast<microseconds>(end - mid).count() / 1000.0
+                << live.flow_value() << live.search_count() - searches_before;
+            out.end_row();
+        }
+    }
+    
+    out.close();
+    cout << "Results saved to " << output_file << '\n';
+}
+
+// Time Dinic on one instance with 1..max_threads level-graph builders
+void benchmark_thread_scaling(int size, double edge_probability, int max_threads,
+                              int trials, const string& output_file) {
+    ResultWriter out(output_file, {"threads", "runtime_ms", "speedup", "flow_value"},
+                     result_formats);
+    
+    mt19937 rng(benchmark_seed);
+    auto problem = generate_random_instance(size, size, edge_probability, rng);
+    cout << "Instance: " << size << " x " << size << ", "
+         << problem->num_feasible_assignments() << " feasible edges" << '\n';
+    
+    double base_ms = 0;
+    for (int threads = 1; threads <= max_threads; threads++) {
+        for (int trial = 0; trial < trials; trial++) {
+            MaxFlow graph(problem->total_nodes());
+            problem->add_network_edges(graph);
+            graph.freeze();
+            graph.set_threads(threads);
+            
+            auto start = high_resolution_clock::now();
+            int flow_value = graph.max_flow(problem->source_node(), problem->sink_node());
+            auto end = high_resolution_clock::now();
+            
+            double runtime_ms = duration_cast<microseconds>(end - start).count() / 1000.0;
+            if (threads == 1 && trial == 0) base_ms = runtime_ms;
+            out << threads << runtime_ms
+                << (runtime_ms > 0 ? base_ms / runtime_ms : 0.0) << flow_value;
+            out.end_row();
+            
+            if (trial == 0) {
+                cout << "  " << threads << " thread(s): " << runtime_ms << " ms, speedup "
+                     << (runtime_ms > 0 ? base_ms / runtime_ms : 0.0) << "x" << '\n';
+            }
+        }
+    }
+    delete problem;
+    
+    out.close();
+    cout << "Results saved to " << output_file << '\n';
+}
+
+// Differential check: the iterative blocking flow against the recursive
+// reference and the other engines on random small networks (capacities
+// below 10, or below 1000 on every other instance so capacity scaling runs
+// several rounds). Returns the number of mismatching instances.
+int run_differential_tests(int instances, unsigned seed) {
+    mt19937 rng(seed);
+    int failures = 0;
+    long long phases = 0, augmentations = 0;
+    
+    for (int it = 0; it < instances; it++) {
+        int n = 2 + rng() % 40;
+        int m = rng() % (4 * n);
+        vector<int> from(m), to(m), cap(m);
+        for (int k = 0; k < m; k++) {
+            from[k] = rng() % n;
+            to[k] = rng() % n;
+            cap[k] = rng() % (it % 2 ? 1000 : 10);
+        }
+        
+        MaxFlow iterative(n), recursive(n), scaling(n), pushrelabel(n);
+        for (int k = 0; k < m; k++) {
+            iterative.add_edge(from[k], to[k], cap[k]);
+            recursive.add_edge(from[k], to[k], cap[k]);
+            scaling.add_edge(from[k], to[k], cap[k]);
+            pushrelabel.add_edge(from[k], to[k], cap[k]);
+        }
+        int a = iterative.max_flow(0, n - 1);
+        int b = recursive.max_flow_recursive(0, n - 1);
+        int c = PushRelabelSolver().solve(pushrelabel, 0, n - 1);
+        int d = scaling.max_flow_scaling(0, n - 1);
+        phases += iterative.last_stats().phases;
+        augmentations += iterative.last_stats().augmentations;
+        
+        if (a != b || a != c || a != d) {
+            cerr << "Mismatch on instance " << it << ": iterative " << a
+                 << ", recursive " << b << ", push-relabel " << c << ", scaling " << d << endl;
+            failures++;
+        }
+    }
+    
+    cout << instances - failures << "/" << instances << " instances agree ("
+         << phases << " phases, " << augmentations << " augmentations)" << '\n';
+    return failures;
+}
+
+// Warm-start check: on geometric instances (unit and multi-seat) whose
+// network the caller built with build_flow_network(), compute_flow() must
+// still seed with Karp-Sipser and reach the cold maximum flow. Returns the
+// number of failing instances.
+int run_warm_start_checks(int instances, unsigned seed) {
+    mt19937 rng(seed);
+    CapacityProfile profiles[] = {UNIT_CAPACITIES, {"pooled_groups", 3, 6, 1, 4}};
+    int failures = 0;
+    
+    for (int it = 0; it < instances; it++) {
+        int size = 50 + rng() % 500;
+        RideShareAssignment* problem = generate_geometric_instance(size, size, 1.6, rng, profiles[it % 2]);
+        problem->set_flow_engine(it % 4 < 2 ? FlowEngine::DINIC : FlowEngine::DINIC_SCALING);
+        problem->set_warm_start(false);
+        int cold = problem->compute_flow();
+        
+        problem->set_warm_start(true);
+        problem->build_flow_network();
+        int warm = problem->compute_flow();
+        long long seeded = problem->last_seed_stats().total();
+        
+        if (warm != cold || (cold > 0 && seeded <= 0) || seeded > warm) {
+            cerr << "Warm start failed on instance " << it << ": seeded " << seeded
+                 << ", flow " << warm << ", expected " << cold << endl;
+            failures++;
+        }
+        delete problem;
+    }
+    
+    cout << instances - failures << "/" << instances << " warm starts seed after build_flow_network()" << '\n';
+    return failures;
+}
+
+// Geometric instances from 1000 up to 10^6 drivers and requests. build_ms
+// is the grid-based edge generation (coordinates are drawn beforehand) and
+// flow_ms the max flow with the AUTO engine.
+void benchmark_geometric(vector<int>& sizes, double radius, int trials,
+                         const string& output_file) {
+    ResultWriter out(output_file, {"size", "runtime_ms", "flow_value", "num_edges", "build_ms",
+                                   "flow_ms"}, result_formats);
+    
+    mt19937 rng(benchmark_seed);
+    
+    for (int size : sizes) {
+        cout << "Benchmarking geometric instances at size " << size << "..." << endl;
+        
+        for (int trial = 0; trial < trials; trial++) {
+            double side = sqrt((double)size);
+            vector<double> driver_x, driver_y, request_x, request_y;
+            generate_points(size, side, rng, driver_x, driver_y);
+            generate_points(size, side, rng, request_x, request_y);
+            
+            auto start = high_resolution_clock::now();
+            RideShareAssignment problem(size, size);
+            problem.add_feasible_within_radius(driver_x, driver_y, request_x, request_y, radius);
+            auto mid = high_resolution_clock::now();
+            int flow_value = problem.compute_flow();
+            auto end = high_resolution_clock::now();
+            
+            out << size
+                << duration_cast<microseconds>(end - start).count() / 1000.0
+                << flow_value << problem.num_feasible_assignments()
+                << duration_cast<microseconds>(mid - start).count() / 1000.0
+                << duration_cast<microseconds>(end - mid).count() / 1000.0;
+            out.end_row();
+        }
+    }
+    
+    out.close();
+    cout << "Results saved to " << output_file << '\n';
+}
+
+// Geometric instances under each capacity profile: Dinic, capacity-scaling
+// Dinic and push-relabel on copies of the same network, with the phases
+// (level graphs) each Dinic variant needed. supply and demand are the
+// total driver capacity and requested seats; flow_value is seats served.
+void benchmark_capacities(vector<int>& sizes, double radius, const vector<CapacityProfile>& profiles,
+                          int trials, const string& output_file) {
+    ResultWriter out(output_file, {"profile", "size", "num_edges", "supply", "demand", "flow_value",
+                                   "dinic_ms", "dinic_phases", "dinic_augmentations", "scaling_ms",
+                                   "scaling_phases", "scaling_rounds", "scaling_augmentations",
+                                   "push_relabel_ms"}, result_formats);
+    
+    for (const CapacityProfile& profile : profiles) {
+        mt19937 rng(benchmark_seed);
+        for (int size : sizes) {
+            cout << "Benchmarking " << profile.name << " capacities at size " << size << "..." << endl;
+            
+            for (int trial = 0; trial < trials; trial++) {
+                auto problem = generate_geometric_instance(size, size, radius, rng, profile);
+                long long supply = 0, demand = 0;
+                for (int i = 0; i < size; i++) supply += problem->driver_capacity(i);
+                for (int j = 0; j < size; j++) demand += problem->request_capacity(j);
+                
+                FlowEngine engines[] = {FlowEngine::DINIC, FlowEngine::DINIC_SCALING,
+                                        FlowEngine::PUSH_RELABEL};
+                double engine_ms[3];
+                FlowStats engine_stats[3];
+                int flow_value = -1;
+                for (int k = 0; k < 3; k++) {
+                    MaxFlow graph(problem->total_nodes());
+                    problem->add_network_edges(graph);
+                    graph.freeze();
+                    auto solver = make_flow_solver(engines[k]);
+                    
+                    auto start = high_resolution_clock::now();
+                    int engine_flow = solver->solve(graph, problem->source_node(), problem->sink_node());
+                    auto end = high_resolution_clock::now();
+                    
+                    if (flow_value >= 0 && engine_flow != flow_value) {
+                        cerr << "Error: " << solver->name() << " found flow " << engine_flow
+                             << ", expected " << flow_value << endl;
+                    }
+                    flow_value = engine_flow;
+                    engine_ms[k] = duration_cast<microseconds>(end - start).count() / 1000.0;
+                    engine_stats[k] = graph.last_stats();
+                }
+                
+                out << profile.name << size << problem->num_feasible_assignments() << supply << demand
+                    << flow_value << engine_ms[0] << engine_stats[0].phases
+                    << engine_stats[0].augmentations << engine_ms[1] << engine_stats[1].phases
+                    << engine_stats[1].scaling_rounds << engine_stats[1].augmentations << engine_ms[2];
+                out.end_row();
+                delete problem;
+            }
+        }
+    }
+    
+    out.close();
+    cout << "Results saved to " << output_file << '\n';
+}
+
+// Warm start: Dinic from zero flow ("cold") against Karp-Sipser seeding
+// followed by Dinic ("warm") on copies of the same geometric network, plus
+// Hopcroft-Karp both ways on unit instances. seeded_fraction is the share
+// of the maximum flow placed by the seeder and saved_ms the cold Dinic
+// time minus seeding and warm Dinic.
+void benchmark_warm_start(vector<int>& sizes, double radius, const vector<CapacityProfile>& profiles,
+                          int trials, const string& output_file) {
+    ResultWriter out(output_file, {"profile", "size", "num_edges", "flow_value", "seeded_flow",
+                                   "seeded_fraction", "degree_one_flow", "greedy_flow", "seed_ms",
+                                   "cold_dinic_ms", "warm_dinic_ms", "saved_ms", "cold_phases",
+                                   "warm_phases", "cold_hopcroft_karp_ms", "warm_hopcroft_karp_ms"},
+                     result_formats);
+    
+    for (const CapacityProfile& profile : profiles) {
+        mt19937 rng(benchmark_seed);
+        bool unit = profile.driver_max == 1 && profile.seats_max == 1;
+        for (int size : sizes) {
+            cout << "Benchmarking warm start (" << profile.name << ") at size " << size << "..." << endl;
+            
+            for (int trial = 0; trial < trials; trial++) {
+                auto problem = generate_geometric_instance(size, size, radius, rng, profile);
+                int s = problem->source_node(), t = problem->sink_node();
+                
+                // Cold and warm runs of one engine; returns the flow value
+                double seed_ms = 0;
+                auto run = [&](FlowEngine e, bool warm, double& ms, FlowStats* stats) {
+                    MaxFlow graph(problem->total_nodes());
+                    vector<int> handles;
+                    problem->add_network_edges(graph, &handles);
+                    graph.freeze();
+                    auto solver = make_flow_solver(e);
+                    int flow = 0;
+                    if (warm) {
+                        auto seed_start = high_resolution_clock::now();
+                        flow = problem->seed_flow(graph, handles);
+                        seed_ms = duration_cast<microseconds>(high_resolution_clock::now() - seed_start).count() / 1000.0;
+                    }
+                    auto start = high_resolution_clock::now();
+                    flow += solver->solve(graph, s, t);
+                    ms = duration_cast<microseconds>(high_resolution_clock::now() - start).count() / 1000.0;
+                    if (stats) *stats = graph.last_stats();
+                    return flow;
+                };
+                
+                double cold_ms, warm_ms;
+                FlowStats cold_stats, warm_stats;
+                int flow_value = run(FlowEngine::DINIC, false, cold_ms, &cold_stats);
+                int warm_flow = run(FlowEngine::DINIC, true, warm_ms, &warm_stats);
+                if (warm_flow != flow_value) {
+                    cerr << "Error: warm start found flow " << warm_flow << ", expected " << flow_value << endl;
+                }
+                const KarpSipserSeeder::Stats& seed = problem->last_seed_stats();
+                
+                out << profile.name << size << problem->num_feasible_assignments() << flow_value
+                    << seed.total() << (flow_value > 0 ? (double)seed.total() / flow_value : 1.0)
+                    << seed.degree_one_flow << seed.greedy_flow << seed_ms << cold_ms << warm_ms
+                    << cold_ms - seed_ms - warm_ms << cold_stats.phases << warm_stats.phases;
+                if (unit) {
+                    double cold_hk_ms, warm_hk_ms;
+                    run(FlowEngine::HOPCROFT_KARP, false, cold_hk_ms, nullptr);
+                    run(FlowEngine::HOPCROFT_KARP, true, warm_hk_ms, nullptr);
+                    out << cold_hk_ms << seed_ms + warm_hk_ms;
+                } else {
+                    out.skip(2);
+                }
+                out.end_row();
+                delete problem;
+            }
+        }
+    }
+    
+    out.close();
+    cout << "Results saved to " << output_file << '\n';
+}
+
+// Loading a geometric instance from CSV (parse) against the mapped binary
+// file, then the first max flow on the loaded instance. The files are
+// written to data/ and removed afterwards; they are usually still in the
+// page cache, so binary_load_ms is a warm-cache figure.
+void benchmark_load(vector<int>& sizes, double radius, const string& output_file) {
+    ResultWriter out(output_file, {"size", "num_edges", "csv_mb", "binary_mb", "csv_load_ms",
+                                   "binary_load_ms", "speedup", "csv_flow_ms", "binary_flow_ms",
+                                   "flow_value"}, result_formats);
+    
+    mt19937 rng(benchmark_seed);
+    
+    for (int size : sizes) {
+        cout << "Benchmarking instance loading at size " << size << "..." << endl;
+        
+        RideShareAssignment* generated = generate_geometric_instance(size, size, radius, rng);
+        string csv_path = "data/rideshare_" + to_string(size) + ".csv";
+        string binary_path = "data/rideshare_" + to_string(size) + ".bin";
+        write_csv_instance(*generated, csv_path);
+        generated->save_instance(binary_path);
+        int num_edges = generated->num_feasible_assignments();
+        delete generated;
+        
+        auto start = high_resolution_clock::now();
+        RideShareAssignment* from_csv = read_csv_instance(csv_path);
+        auto csv_loaded = high_resolution_clock::now();
+        int csv_flow = from_csv->compute_flow();
+        auto csv_solved = high_resolution_clock::now();
+        RideShareAssignment* from_binary = RideShareAssignment::load_instance(binary_path);
+        auto binary_loaded = high_resolution_clock::now();
+        int binary_flow = from_binary->compute_flow();
+        auto binary_solved = high_resolution_clock::now();
+        
+        if (csv_flow != binary_flow) {
+            cerr << "Error: CSV and binary instances give flows " << csv_flow
+                 << " and " << binary_flow << endl;
+        }
+        
+        ifstream csv_file(csv_path, ios::binary | ios::ate), binary_file(binary_path, ios::binary | ios::ate);
+        double csv_mb = csv_file.tellg() / 1e6, binary_mb = binary_file.tellg() / 1e6;
+        double csv_ms = duration_cast<microseconds>(csv_loaded - start).count() / 1000.0;
+        double binary_ms = duration_cast<microseconds>(binary_loaded - csv_solved).count() / 1000.0;
+        out << size << num_edges << csv_mb << binary_mb
+            << csv_ms << binary_ms << (binary_ms > 0 ? csv_ms / binary_ms : 0.0)
+            << duration_cast<microseconds>(csv_solved - csv_loaded).count() / 1000.0
+            << duration_cast<microseconds>(binary_solved - binary_loaded).count() / 1000.0
+            << binary_flow;
+        out.end_row();
+        
+        delete from_csv;
+        delete from_binary;
+        remove(csv_path.c_str());
+        remove(binary_path.c_str());
+    }
+    
+    out.close();
+    cout << "Results saved to " << output_file << '\n';
+}
+
+// Dispatch ticks on geometric instances: a new RideShareAssignment per
+// tick ("fresh", as the other benchmarks do) against one object reset()
+// every tick ("reuse"). Both modes see the same instances. Per tick:
+// heap allocations and bytes requested (alloc_stats.h, only when built
+// with -DALLOC_STATS), time to fill the instance and to solve + extract,
+// and the peak RSS during the tick (the process peak where it cannot be
+// reset).
+void benchmark_allocation(vector<int>& sizes, double radius, int ticks,
+                          const string& output_file) {
+    ResultWriter out(output_file, {"mode", "size", "tick", "allocations", "alloc_mb", "fill_ms",
+                                   "solve_ms", "flow_value", "peak_rss_mb"}, result_formats);
+
+    for (int size : sizes) {
+        cout << "Benchmarking allocation at size " << size << "..." << endl;
+        double side = sqrt((double)size);
+
+        for (int reuse = 0; reuse < 2; reuse++) {
+            mt19937 rng(benchmark_seed);
+            vector<double> driver_x, driver_y, request_x, request_y;
+            RideShareAssignment* kept = reuse ? new RideShareAssignment(size, size) : nullptr;
+
+            for (int tick = 0; tick < ticks; tick++) {
+                generate_points(size, side, rng, driver_x, driver_y);
+                generate_points(size, side, rng, request_x, request_y);
+                reset_peak_rss();
+                AllocStats before = alloc_snapshot();
+
+                auto start = high_resolution_clock::now();
+                RideShareAssignment* problem = kept;
+                if (kept) {
+                    kept->reset(size, size);
+                } else {
+                    problem = new RideShareAssignment(size, size);
+                }
+                problem->add_feasible_within_radius(driver_x, driver_y, request_x, request_y, radius);
+                auto mid = high_resolution_clock::now();
+                int flow_value = problem->compute_flow();
+                auto assignments = problem->extract_assignments();
+                auto end = high_resolution_clock::now();
+                if (!kept) delete problem;
+
+                AllocStats used = alloc_since(before);
+                out << (reuse ? "reuse" : "fresh") << size << tick;
+                if (alloc_counting) {
+                    out << used.allocations << used.bytes / 1048576.0;
+                } else {
+                    out.skip(2);
+                }
+                out << duration_cast<microseconds>(mid - start).count() / 1000.0
+                    << duration_cast<microseconds>(end - mid).count() / 1000.0
+                    << flow_value << peak_rss_bytes() / 1048576.0;
+                out.end_row();
+            }
+            delete kept;
+        }
+    }
+
+    out.close();
+    cout << "Results saved to " << output_file << '\n';
+}
+
+// Min-cost max-flow on sparse instances, against plain max flow. runtime_ms
+// includes the max flow that solve_min_cost() runs to count the seats.
+void benchmark_min_cost(vector<int>& sizes, int degree, int trials,
+                        const string& output_file) {
+    ResultWriter out(output_file, {"size", "num_edges", "runtime_ms", "flow_value",
+                                   "total_cost", "refines", "relabels", "price_updates",
+                                   "max_flow_ms"},
+                     result_formats);
+    
+    mt19937 rng(benchmark_seed);
+    
+    for (int size : sizes) {
+        cout << "Benchmarking min-cost flow at size " << size << "..." << endl;
+        double min_cost_total = 0, max_flow_total = 0;
+        
+        for (int trial = 0; trial < trials; trial++) {
+            auto problem = generate_sparse_cost_instance(size, size, degree, 1000, rng);
+            
+            auto start = high_resolution_clock::now();
+            auto result = problem->solve_min_cost();
+            auto mid = high_resolution_clock::now();
+            int flow_value = problem->solve().first;
+            auto end = high_resolution_clock::now();
+            
+            if (flow_value != result.flow_value) {
+                cerr << "Error: min-cost flow " << result.flow_value
+                     << " differs from max flow " << flow_value << endl;
+            }
+            
+            double min_cost_ms = duration_cast<microseconds>(mid - start).count() / 1000.0;
+            double max_flow_ms = duration_cast<microseconds>(end - mid).count() / 1000.0;
+            min_cost_total += min_cost_ms;
+            max_flow_total += max_flow_ms;
+            
+            out << size << problem->num_feasible_assignments() << min_cost_ms
+                << result.flow_value << result.total_cost
+                << result.refines << result.relabels << result.price_updates
+                << max_flow_ms;
+            out.end_row();
+            
+            delete problem;
+        }
+        
+        cout << "  Mean min-cost flow: " << min_cost_total / trials << " ms (max flow "
+             << max_flow_total / trials << " ms)" << '\n';
+    }
+    
+    out.close();
+    cout << "Results saved to " << output_file << '\n';
+}
+
+// One batch job: read the instance file into this worker's reusable object
+// (binary format when the name ends in ".bin", driver,request[,cost] CSV
+// otherwise) and solve it. Result line:
+// file,drivers,requests,pairs,flow_value,load_ms,solve_ms or file,error
+string solve_batch_instance(RideShareAssignment& problem, const string& path) {
+    auto start = high_resolution_clock::now();
+    bool binary = path.size() >= 4 && path.compare(path.size() - 4, 4, ".bin") == 0;
+    bool loaded = binary ? RideShareAssignment::load_instance(path, problem)
+                         : read_csv_instance(path, problem);
+    if (!loaded) return path + ",error";
+    auto mid = high_resolution_clock::now();
+    int flow_value = problem.compute_flow();
+    auto end = high_resolution_clock::now();
+    
+    ostringstream line;
+    line << path << ',' << problem.drivers() << ',' << problem.requests() << ','
+         << problem.num_feasible_assignments() << ',' << flow_value << ','
+         << duration_cast<microseconds>(mid - start).count() / 1000.0 << ','
+         << duration_cast<microseconds>(end - mid).count() / 1000.0;
+    return line.str();
+}
+
+// Batch mode: solve the instance files (or, when none are given, one path
+// per line of stdin, read while earlier instances are being solved) on
+// `threads` workers, each with its own reusable RideShareAssignment.
+// Results go to cout as CSV in input order; a summary goes to cerr.
+// Returns the number of instances that could not be loaded.
+int run_batch(int threads, const vector<string>& files) {
+    vector<unique_ptr<RideShareAssignment>> worker_problems;
+    for (int w = 0; w < threads; w++) worker_problems.emplace_back(new RideShareAssignment(0, 0));
+    atomic<int> errors(0);
+    
+    cout << "file,drivers,requests,pairs,flow_value,load_ms,solve_ms" << '\n';
+    auto start = high_resolution_clock::now();
+    BatchPool pool(threads, [&](int w, const string& path) {
+        string result = solve_batch_instance(*worker_problems[w], path);
+        if (result.size() >= 6 && result.compare(result.size() - 6, 6, ",error") == 0) errors++;
+        return result;
+    }, cout);
+    if (files.empty()) {
+        string line;
+        while (getline(cin, line)) {
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            if (!line.empty()) pool.submit(line);
+        }
+    } else {
+        for (const string& file : files) pool.submit(file);
+    }
+    size_t count = pool.finish();
+    double ms = duration_cast<microseconds>(high_resolution_clock::now() - start).count() / 1000.0;
+    
+    cerr << "Solved " << count << " instances in " << ms << " ms ("
+         << (ms > 0 ? count * 1000.0 / ms : 0.0) << " per second) on " << threads
+         << " threads; " << pool.steals() << " stolen, " << errors << " failed" << endl;
+    return errors;
+}
+
+// Batch throughput: `instances` geometric zones with sizes spread over
+// [size / 4, 7 * size / 4) are written as binary files, then solved by
+// run_batch's pool with 1, 2, 4, ... up to max_threads workers. Results
+// are discarded; the files are removed afterwards.
+void benchmark_batch(int instances, int size, double radius, int max_threads,
+                     const string& output_file) {
+    ResultWriter out(output_file, {"threads", "instances", "total_ms", "instances_per_sec",
+                                   "speedup", "steals"}, result_formats);
+    
+    mt19937 rng(benchmark_seed);
+    uniform_int_distribution<int> zone_size(size / 4, 7 * size / 4 - 1);
+    vector<string> files;
+    for (int k = 0; k < instances; k++) {
+        int zone = zone_size(rng);
+        RideShareAssignment* problem = generate_geometric_instance(zone, zone, radius, rng);
+        files.push_back("data/batch_zone_" + to_string(k) + ".bin");
+        problem->save_instance(files.back());
+        delete problem;
+    }
+    
+    vector<int> thread_counts;
+    for (int t = 1; t < max_threads; t *= 2) thread_counts.push_back(t);
+    thread_counts.push_back(max_threads);
+    
+    double base_rate = 0;
+    for (int threads : thread_counts) {
+        cout << "Benchmarking batch of " << instances << " zones on " << threads << " threads..." << endl;
+        vector<unique_ptr<RideShareAssignment>> worker_problems;
+        for (int w = 0; w < threads; w++) worker_problems.emplace_back(new RideShareAssignment(0, 0));
+        ostream discard(nullptr);
+        
+        auto start = high_resolution_clock::now();
+        BatchPool pool(threads, [&](int w, const string& path) {
+            return solve_batch_instance(*worker_problems[w], path);
+        }, discard);
+        for (const string& file : files) pool.submit(file);
+        pool.finish();
+        double ms = duration_cast<microseconds>(high_resolution_clock::now() - start).count() / 1000.0;
+        
+        double rate = ms > 0 ? instances * 1000.0 / ms : 0.0;
+        if (threads == 1) base_rate = rate;
+        out << threads << instances << ms << rate << (base_rate > 0 ? rate / base_rate : 0.0)
+            << pool.steals();
+        out.end_row();
+    }
+    
+    for (const string& file : files) remove(file.c_str());
+    out.close();
+    cout << "Results saved to " << output_file << '\n';
+}
+
+// Reproducible benchmark suite (see bench_harness.h): fixed-seed instances,
+// per-stage timings, a JSON baseline, and a comparison against an old one.
+// Returns the number of regressions found (0 when not comparing).
+int run_bench_suite(const string& output_file, const string& baseline_file,
+                    double threshold, int repetitions) {
+    BenchSuite suite("problem1_rideshare", benchmark_seed, 2, repetitions);
+
+    for (int size : {200, 500, 1000}) {
+        suite.add("random_p0.1_n" + to_string(size), [size](BenchRun& run) {
+            RideShareAssignment* problem = nullptr;
+            int flow_value = 0;
+            vector<pair<int, int>> assignments;
+            run.time("generate", [&] { problem = generate_random_instance(size, size, 0.1, run.rng); });
+            run.time("build", [&] { problem->build_flow_network(); });
+            run.time("solve", [&] { flow_value = problem->compute_flow(); });
+            run.time("extract", [&] { assignments = problem->extract_assignments(); });
+            run.check("flow_value", flow_value);
+            run.check("num_edges", problem->num_feasible_assignments());
+            delete problem;
+        });
+    }
+
+    suite.add("geometric_r1.6_n100000", [](BenchRun& run) {
+        RideShareAssignment* problem = nullptr;
+        int flow_value = 0;
+        vector<pair<int, int>> assignments;
+        run.time("generate", [&] { problem = generate_geometric_instance(100000, 100000, 1.6, run.rng); });
+        run.time("build", [&] { problem->build_flow_network(); });
+        run.time("solve", [&] { flow_value = problem->compute_flow(); });
+        run.time("extract", [&] { assignments = problem->extract_assignments(); });
+        run.check("flow_value", flow_value);
+        run.check("num_edges", problem->num_feasible_assignments());
+        delete problem;
+    });
+
+    suite.add("mincost_d10_n2000", [](BenchRun& run) {
+        RideShareAssignment* problem = nullptr;
+        RideShareAssignment::MinCostResult result = {};
+        run.time("generate", [&] { problem = generate_sparse_cost_instance(2000, 2000, 10, 1000, run.rng); });
+        run.time("solve", [&] { result = problem->solve_min_cost(); });
+        run.check("flow_value", result.flow_value);
+        run.check("total_cost", result.total_cost);
+        delete problem;
+    });
+
+    suite.run();
+    if (suite.write_json(output_file)) {
+        cout << "\nResults saved to " << output_file << '\n';
+    } else {
+        cerr << "Error: cannot write " << output_file << endl;
+    }
+    if (baseline_file.empty()) return 0;
+
+    int regressions = suite.compare(baseline_file, threshold);
+    if (regressions < 0) return 1;
+    cout << "\n" << regressions << " regression(s) above " << threshold * 100 << "%" << '\n';
+    return regressions;
+}
+
+// Demonstration example
+void demo_example() {
+    cout << "\n============================================================" << '\n';
+    cout << "Demonstration: Small Example" << '\n';
+    cout << "============================================================\n" << '\n';
+    
+    // Create small instance: 3 drivers, 4 requests
+    RideShareAssignment problem(3, 4);
+    
+    // Set capacities
+    for (int i = 0; i < 3; i++) {
+        problem.set_driver_capacity(i, 1);
+    }
+    
+    // Define feasible assignments
+    problem.add_feasible_assignment(0, 0);
+    problem.add_feasible_assignment(0, 1);
+    problem.add_feasible_assignment(1, 1);
+    problem.add_feasible_assignment(1, 2);
+    problem.add_feasible_assignment(2, 2);
+    problem.add_feasible_assignment(2, 3);
+    
+    cout << "Problem Setup:" << '\n';
+    cout << "  Drivers: 3 (each with capacity 1)" << '\n';
+    cout << "  Requests: 4" << '\n';
+    cout << "  Feasible assignments:" << '\n';
+    cout << "    Driver 0 → Requests {0, 1}" << '\n';
+    cout << "    Driver 1 → Requests {1, 2}" << '\n';
+    cout << "    Driver 2 → Requests {2, 3}" << '\n';
+    
+    // Solve
+    auto result = problem.solve();
+    int flow_value = result.first;
+    auto assignments = result.second;
+    
+    cout << "\nSolution:" << '\n';
+    cout << "  Maximum flow value: " << flow_value << '\n';
+    cout << "  Assignments:" << '\n';
+    for (auto& p : assignments) {
+        cout << "    Driver " << p.first << " → Request " << p.second << '\n';
+    }
+    
+    cout << '\n';
+    problem.print_stats();
+}
+
+int main(int argc, char* argv[]) {
+    for (int k = 1; k < argc; k++) {
+        if (string(argv[k]) == "--columns") result_formats |= RESULT_COLUMNS;
+        if (string(argv[k]) == "--seed" && k + 1 < argc) benchmark_seed = strtoul(argv[k + 1], nullptr, 10);
+    }
+    
+    // Batch mode writes only results to stdout: no banner or demo
+    if (argc > 1 && string(argv[1]) == "--batch") {
+        int threads = max(1u, thread::hardware_concurrency());
+        vector<string> files;
+        for (int k = 2; k < argc; k++) {
+            if (string(argv[k]) == "--threads" && k + 1 < argc) {
+                threads = max(1, atoi(argv[++k]));
+            } else if (string(argv[k]) == "--columns") {
+                // global flags, already read above
+            } else if (string(argv[k]) == "--seed" && k + 1 < argc) {
+                k++;
+            } else {
+                files.push_back(argv[k]);
+            }
+        }
+        return run_batch(threads, files) == 0 ? 0 : 1;
+    }
+    
+    cout << "============================================================" << '\n';
+    cout << "Problem 1: Ride-Share Driver Assignment Experiments" << '\n';
+    cout << "============================================================\n" << '\n';
+    
+    // Run demonstration
+    demo_example();
+    
+    // Run benchmarks if requested
+    if (argc > 1 && string(argv[1]) == "--benchmark") {
+        cout << "\n============================================================" << '\n';
+        cout << "Running Benchmarks" << '\n';
+        cout << "============================================================\n" << '\n';
+        
+        vector<int> sizes = {50, 100, 200, 300, 400, 500, 750, 1000};
+        vector<double> edge_probs = {0.1, 0.3, 0.5};
+        int trials = 5;
+        
+        for (double p : edge_probs) {
+            cout << "\nEdge probability p = " << p << '\n';
+            string filename = "data/flow_p" + to_string((int)(p * 10)) + ".csv";
+            benchmark_runtime(sizes, p, trials, filename);
+        }
+        
+        cout << "\n============================================================" << '\n';
+        cout << "Benchmarks completed!" << '\n';
+        cout << "Run Python script to generate plots from CSV data." << '\n';
+        cout << "============================================================" << '\n';
+    } else if (argc > 1 && string(argv[1]) == "--benchmark-layout") {
+        cout << "\n============================================================" << '\n';
+        cout << "Residual Graph Layout Benchmark (adjacency list vs CSR)" << '\n';
+        cout << "============================================================\n" << '\n';
+        
+        vector<int> sizes = {500, 1000, 2000, 4000};
+        benchmark_layout(sizes, 0.1, 5, "data/flow_layout.csv");
+    } else if (argc > 1 && string(argv[1]) == "--benchmark-incremental") {
+        cout << "\n============================================================" << '\n';
+        cout << "Incremental Re-matching Benchmark" << '\n';
+        cout << "============================================================\n" << '\n';
+        
+        vector<int> changes = {1, 10, 100, 1000};
+        benchmark_incremental(5000, 0.002, 20, changes, "data/flow_incremental.csv");
+    } else if (argc > 1 && string(argv[1]) == "--benchmark-scaling") {
+        cout << "\n============================================================" << '\n';
+        cout << "Parallel Level-Graph Scaling Benchmark" << '\n';
+        cout << "============================================================\n" << '\n';
+        
+        int max_threads = argc > 2 ? atoi(argv[2]) : (int)max(1u, thread::hardware_concurrency());
+        benchmark_thread_scaling(10000, 0.005, max_threads, 3, "data/flow_scaling.csv");
+    } else if (argc > 1 && string(argv[1]) == "--benchmark-mincost") {
+        cout << "\n============================================================" << '\n';
+        cout << "Min-Cost Max-Flow Benchmark" << '\n';
+        cout << "============================================================\n" << '\n';
+        
+        vector<int> sizes = {1000, 5000, 10000, 25000, 50000};
+        benchmark_min_cost(sizes, 10, 3, "data/flow_mincost.csv");
+    } else if (argc > 1 && string(argv[1]) == "--benchmark-geometric") {
+        cout << "\n============================================================" << '\n';
+        cout << "Geometric (grid-indexed) Instance Benchmark" << '\n';
+        cout << "============================================================\n" << '\n';
+        
+        vector<int> sizes = {1000, 10000, 100000, 1000000};
+        benchmark_geometric(sizes, 1.6, 3, "data/flow_geometric.csv");
+    } else if (argc > 1 && string(argv[1]) == "--benchmark-load") {
+        cout << "\n============================================================" << '\n';
+        cout << "Instance Loading Benchmark (CSV vs mapped binary)" << '\n';
+        cout << "============================================================\n" << '\n';
+        
+        vector<int> sizes = {10000, 100000, 1000000};
+        benchmark_load(sizes, 1.6, "data/flow_load.csv");
+    } else if (argc > 1 && string(argv[1]) == "--benchmark-alloc") {
+        cout << "\n============================================================" << '\n';
+        cout << "Allocation Benchmark (fresh objects vs reset and reuse)" << '\n';
+        cout << "============================================================\n" << '\n';
+        
+        vector<int> sizes = {10000, 100000};
+        benchmark_allocation(sizes, 1.6, 20, "data/flow_alloc.csv");
+    } else if (argc > 1 && string(argv[1]) == "--benchmark-capacity") {
+        cout << "\n============================================================" << '\n';
+        cout << "Capacity Sweep (unit seats to high-capacity hubs)" << '\n';
+        cout << "============================================================\n" << '\n';
+        
+        // Solo rides, pooled cars, pooled cars with parties, shuttles,
+        // and hubs with charter groups (large capacities)
+        vector<CapacityProfile> profiles = {
+            UNIT_CAPACITIES,
+            {"pooled", 3, 6, 1, 1},
+            {"pooled_groups", 3, 6, 1, 4},
+            {"shuttle", 10, 50, 1, 10},
+            {"hub", 100, 1000, 10, 200}};
+        vector<int> sizes = {10000, 100000, 1000000};
+        benchmark_capacities(sizes, 1.6, profiles, 2, "data/flow_capacity.csv");
+    } else if (argc > 1 && string(argv[1]) == "--benchmark-warm-start") {
+        cout << "\n============================================================" << '\n';
+        cout << "Warm Start (Karp-Sipser seeding before Dinic)" << '\n';
+        cout << "============================================================\n" << '\n';
+        
+        vector<CapacityProfile> profiles = {UNIT_CAPACITIES, {"pooled_groups", 3, 6, 1, 4}};
+        vector<int> sizes = {10000, 100000, 1000000};
+        benchmark_warm_start(sizes, 1.6, profiles, 2, "data/flow_warm_start.csv");
+    } else if (argc > 1 && string(argv[1]) == "--benchmark-batch") {
+        cout << "\n============================================================" << '\n';
+        cout << "Batch Throughput Benchmark (work-stealing pool over zone files)" << '\n';
+        cout << "============================================================\n" << '\n';
+        
+        int max_threads = argc > 2 ? atoi(argv[2]) : (int)max(1u, thread::hardware_concurrency());
+        benchmark_batch(256, 20000, 1.6, max(1, max_threads), "data/flow_batch.csv");
+    } else if (argc > 3 && string(argv[1]) == "--convert-csv") {
+        return convert_csv_instance(argv[2], argv[3]) ? 0 : 1;
+    } else if (argc > 2 && string(argv[1]) == "--load") {
+        auto start = high_resolution_clock::now();
+        RideShareAssignment* problem = RideShareAssignment::load_instance(argv[2]);
+        if (!problem) return 1;
+        auto mid = high_resolution_clock::now();
+        int flow_value = problem->compute_flow();
+        auto end = high_resolution_clock::now();
+        
+        cout << "\nLoaded " << argv[2] << " in "
+             << duration_cast<microseconds>(mid - start).count() / 1000.0 << " ms" << '\n';
+        problem->print_stats();
+        cout << "Maximum matching: " << flow_value << " ("
+             << duration_cast<microseconds>(end - mid).count() / 1000.0 << " ms)" << '\n';
+        delete problem;
+    } else if (argc > 1 && string(argv[1]) == "--bench-suite") {
+        cout << "\n============================================================" << '\n';
+        cout << "Benchmark Suite (seed " << benchmark_seed << ")" << '\n';
+        cout << "============================================================\n" << '\n';
+        
+        string output = argc > 2 && argv[2][0] != '-' ? argv[2] : "data/bench_baseline_problem1.json";
+        int repetitions = argc > 3 && argv[3][0] != '-' ? atoi(argv[3]) : 30;
+        run_bench_suite(output, "", 0, repetitions);
+    } else if (argc > 2 && string(argv[1]) == "--bench-compare") {
+        cout << "\n============================================================" << '\n';
+        cout << "Benchmark Suite vs " << argv[2] << " (seed " << benchmark_seed << ")" << '\n';
+        cout << "============================================================\n" << '\n';
+        
+        double threshold = argc > 3 && argv[3][0] != '-' ? atof(argv[3]) : 0.10;
+        int repetitions = argc > 4 && argv[4][0] != '-' ? atoi(argv[4]) : 30;
+        return run_bench_suite("data/bench_current_problem1.json", argv[2], threshold, repetitions) == 0 ? 0 : 1;
+    } else if (argc > 1 && string(argv[1]) == "--differential") {
+        cout << "\n============================================================" << '\n';
+        cout << "Differential Check: iterative vs recursive blocking flow" << '\n';
+        cout << "============================================================\n" << '\n';
+        
+        int instances = argc > 2 ? atoi(argv[2]) : 10000;
+        int failures = run_differential_tests(instances, 12345);
+        failures += run_warm_start_checks(200, 12345);
+        return failures == 0 ? 0 : 1;
     } else {
-        cout << "\nTo run benchmarks, use: " << argv[0] << " --benchmark" << endl;
+        cout << "\nTo run benchmarks, use: " << argv[0] << " --benchmark" << '\n';
     }
     
     return 0;
@@ -12,16 +12,39 @@
 #include <iostream>
 #include <vector>
 #include <set>
+#include <queue>
 #include <algorithm>
 #include <cmath>
 #include <random>
 #include <chrono>
 #include <fstream>
 #include <iomanip>
+#include <cstdint>
+#include <new>
+#include <limits>
+#include <climits>
+#include <memory>
+#include <functional>
+#include <thread>
+#include <atomic>
+#include <sstream>
+#include "thread_pool.h"
+#include "instance_io.h"
+#include "result_writer.h"
+#include "bench_harness.h"
+#include "instrument.h"
+#include "alloc_stats.h"
+#include "batch_pool.h"
 
 using namespace std;
 using namespace std::chrono;
 
+// Outputs of the benchmark tables: CSV, plus the column dump with --columns
+int result_formats = RESULT_CSV;
+
+// Seed of every benchmark instance generator (--seed N), so runs repeat
+uint32_t benchmark_seed = 12345;
+
 // Represent a 2D point
 struct Point {
     double x, y;
@@ -31,131 +54,1684 @@ struct Point {
         double dy = y - other.y;
         return sqrt(dx * dx + dy * dy);
     }
-};
-
-// Bus Stop Placement Problem
-class BusStopPlacement {
-public:
-    int num_students;
-    int num_candidates;
-    vector<set<int>> coverage;  // coverage[i] = students covered by stop i
-    vector<Point> student_positions;
-    vector<Point> stop_positions;
+};
+
+// std::allocator replacement handing out 64-byte aligned blocks (one cache
+// line, one AVX-512 register), so bitset rows never straddle a line
+template <typename T>
+struct CacheAlignedAllocator {
+    using value_type = T;
+    
+    CacheAlignedAllocator() = default;
+    template <typename U>
+    CacheAlignedAllocator(const CacheAlignedAllocator<U>&) {}
+    
+    T* allocate(size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), align_val_t(64)));
+    }
+    void deallocate(T* p, size_t) {
+        ::operator delete(p, align_val_t(64));
+    }
+    
+    template <typename U>
+    bool operator==(const CacheAlignedAllocator<U>&) const { return true; }
+    template <typename U>
+    bool operator!=(const CacheAlignedAllocator<U>&) const { return false; }
+};
+
+typedef vector<uint64_t, CacheAlignedAllocator<uint64_t>> AlignedWords;
+
+// Bitset kernels: plain word loops that GCC/Clang vectorize (AND-NOT with
+// AVX2/AVX-512, popcount with AVX-512 VPOPCNTDQ) under -O3 -march=native
+
+// |a & ~b|: students of a not yet in b
+inline int count_and_not(const uint64_t* a, const uint64_t* b, int words) {
+    int count = 0;
+    for (int w = 0; w < words; w++) {
+        count += __builtin_popcountll(a[w] & ~b[w]);
+    }
+    return count;
+}
+
+// dst |= src
+inline void or_into(uint64_t* dst, const uint64_t* src, int words) {
+    for (int w = 0; w < words; w++) {
+        dst[w] |= src[w];
+    }
+}
+
+inline int count_bits(const uint64_t* a, int words) {
+    int count = 0;
+    for (int w = 0; w < words; w++) {
+        count += __builtin_popcountll(a[w]);
+    }
+    return count;
+}
+
+// How candidate stops store the students they cover
+enum class CoverageMode {
+    AUTO,    // Per stop: bitset when it is smaller than the posting list
+    LIST,    // Sorted vector<int> posting lists
+    BITSET   // Word-packed bitsets over all students
+};
+
+// Outcome of the budgeted / max-coverage greedy
+struct CoverageResult {
+    vector<int> stops;
+    int covered;    // Students covered by the stops
+    double cost;    // Total cost of the stops
+};
+
+// Work done by the last greedy_set_cover() call. Filled only when
+// compiled with -DINSTRUMENT (see instrument.h).
+struct GreedyStats {
+    long long iterations = 0;         // Stops selected
+    long long gain_evaluations = 0;   // newly_covered() calls (lazy re-evaluations)
+    long long elements_scanned = 0;   // Bitset words or list entries they read
+    double select_ms = 0;             // Wall time choosing the next stop
+    double cover_ms = 0;              // Wall time marking its students covered
+};
+
+// Magic of bus stop instance files (see instance_io.h). Sections:
+// 0 student x/y pairs, 1 stop x/y pairs (double), 2 CSR offsets (m + 1),
+// 3 students of each stop, sorted (int32), 4 stop costs (double; absent
+// when all are 1). Counts: students, stops, coverage entries.
+const char BUSSTOP_MAGIC[8] = {'B', 'U', 'S', 'S', 'T', 'O', 'P', '1'};
+static_assert(sizeof(Point) == 2 * sizeof(double), "Point must be stored as an x/y pair");
+
+// Posting list viewed in place (owned vector or mapped file)
+struct StudentRange {
+    const int* first;
+    const int* last;
+    const int* begin() const { return first; }
+    const int* end() const { return last; }
+};
+
+// Bus Stop Placement Problem
+class BusStopPlacement {
+public:
+    int num_students;
+    int num_candidates;
+    vector<Point> student_positions;
+    vector<Point> stop_positions;
+    
+private:
+    // Coverage of stop j: a sorted posting list coverage_list[j], or, when
+    // bitset_slot[j] >= 0, the row of bitset_words starting at
+    // bitset_slot[j] * stride (stride = words rounded up to a cache line)
+    CoverageMode mode;
+    vector<vector<int>> coverage_list;
+    vector<int> coverage_count;
+    vector<double> stop_costs;    // Per-stop cost (permits, road safety); 1 by default
+    vector<int> bitset_slot;
+    vector<int> free_slots;
+    AlignedWords bitset_words;
+    int words, stride;
+    
+    // Loaded instances keep every stop's posting list in the mapped file
+    // (mapped_start != nullptr) until the first set_coverage() copies them
+    shared_ptr<MappedFile> mapping;
+    const int* mapped_start;
+    const int* mapped_students;
+    
+    // Workers for the parallel greedy (enabled by set_threads)
+    unique_ptr<ThreadPool> pool;
+    
+    GreedyStats greedy_stats;
+    
+    bool use_bitset(int count) const {
+        if (mode == CoverageMode::AUTO) return count > 0 && 4LL * count >= 8LL * stride;
+        return mode == CoverageMode::BITSET;
+    }
+    
+    const uint64_t* bitset_row(int stop_id) const {
+        return bitset_words.data() + (size_t)bitset_slot[stop_id] * stride;
+    }
+    
+    StudentRange list_of(int stop_id) const {
+        if (mapped_start) {
+            return {mapped_students + mapped_start[stop_id], mapped_students + mapped_start[stop_id + 1]};
+        }
+        const vector<int>& list = coverage_list[stop_id];
+        return {list.data(), list.data() + list.size()};
+    }
+    
+    void detach_mapping() {
+        for (int j = 0; j < num_candidates; j++) {
+            StudentRange list = list_of(j);
+            coverage_list[j].assign(list.begin(), list.end());
+        }
+        mapping.reset();
+        mapped_start = mapped_students = nullptr;
+    }
+    
+    // Marginal gain of a stop against the covered-students bitset
+    int newly_covered(int stop_id, const AlignedWords& covered) const {
+        if (bitset_slot[stop_id] >= 0) {
+            return count_and_not(bitset_row(stop_id), covered.data(), words);
+        }
+        int gain = 0;
+        for (int student : list_of(stop_id)) {
+            if (!(covered[student >> 6] >> (student & 63) & 1)) gain++;
+        }
+        return gain;
+    }
+    
+    // Bitset words or list entries read by newly_covered(stop_id)
+    int evaluation_size(int stop_id) const {
+        return bitset_slot[stop_id] >= 0 ? words : coverage_count[stop_id];
+    }
+    
+    void cover(int stop_id, AlignedWords& covered) const {
+        if (bitset_slot[stop_id] >= 0) {
+            or_into(covered.data(), bitset_row(stop_id), words);
+            return;
+        }
+        for (int student : list_of(stop_id)) {
+            covered[student >> 6] |= 1ULL << (student & 63);
+        }
+    }
+    
+    // Lazy cost-effectiveness greedy shared by the weighted and budgeted
+    // modes: repeatedly takes the affordable stop with the largest
+    // gain / cost (gain alone when unweighted; ties to the lowest index)
+    // until everyone is covered, max_stops are chosen or nothing affordable
+    // adds coverage. A stop that no longer fits the remaining budget never
+    // fits again, so it is dropped from the heap for good.
+    CoverageResult cost_effective_greedy(bool weighted, double budget, int max_stops) const {
+        CoverageResult result{vector<int>(), 0, 0.0};
+        AlignedWords covered(stride, 0);
+        
+        auto ratio = [&](int gain, int stop) {
+            return weighted ? gain / stop_costs[stop] : (double)gain;
+        };
+        vector<pair<double, int>> bounds;
+        for (int j = 0; j < num_candidates; j++) {
+            if (coverage_count[j] > 0) bounds.push_back({ratio(coverage_count[j], j), -j});
+        }
+        priority_queue<pair<double, int>> heap(less<pair<double, int>>(), move(bounds));
+        
+        while (result.covered < num_students && (int)result.stops.size() < max_stops && !heap.empty()) {
+            int stop = -heap.top().second;
+            heap.pop();
+            if (weighted && result.cost + stop_costs[stop] > budget) continue;
+            
+            int gain = newly_covered(stop, covered);
+            if (gain == 0) continue;
+            pair<double, int> key(ratio(gain, stop), -stop);
+            if (!heap.empty() && key < heap.top()) {
+                heap.push(key);
+                continue;
+            }
+            
+            result.stops.push_back(stop);
+            result.covered += gain;
+            result.cost += stop_costs[stop];
+            cover(stop, covered);
+        }
+        
+        return result;
+    }
+    
+public:
+    BusStopPlacement(int n_students, int n_candidates)
+        : num_students(n_students), num_candidates(n_candidates), mode(CoverageMode::AUTO),
+          mapped_start(nullptr), mapped_students(nullptr) {
+        words = (n_students + 63) / 64;
+        stride = (words + 7) / 8 * 8;
+        coverage_list.resize(n_candidates);
+        coverage_count.resize(n_candidates, 0);
+        stop_costs.resize(n_candidates, 1.0);
+        bitset_slot.resize(n_candidates, -1);
+        student_positions.resize(n_students);
+        stop_positions.resize(n_candidates);
+    }
+    
+    // Students may come in any order; duplicates are dropped. They are
+    // copied into the stop's own list, which keeps its capacity across
+    // reset(), so refilling a reused instance does not allocate.
+    void set_coverage(int stop_id, const vector<int>& covered_students) {
+        if (mapped_start) detach_mapping();
+        vector<int>& list = coverage_list[stop_id];
+        list.assign(covered_students.begin(), covered_students.end());
+        sort(list.begin(), list.end());
+        list.erase(unique(list.begin(), list.end()), list.end());
+        coverage_count[stop_id] = list.size();
+        
+        if (!use_bitset(list.size())) {
+            if (bitset_slot[stop_id] >= 0) {
+                free_slots.push_back(bitset_slot[stop_id]);
+                bitset_slot[stop_id] = -1;
+            }
+            return;
+        }
+        
+        if (bitset_slot[stop_id] < 0) {
+            if (!free_slots.empty()) {
+                bitset_slot[stop_id] = free_slots.back();
+                free_slots.pop_back();
+            } else {
+                bitset_slot[stop_id] = bitset_words.size() / max(stride, 1);
+                bitset_words.resize(bitset_words.size() + stride, 0);
+            }
+        }
+        uint64_t* row = bitset_words.data() + (size_t)bitset_slot[stop_id] * stride;
+        fill(row, row + stride, 0);
+        for (int student : list) {
+            row[student >> 6] |= 1ULL << (student & 63);
+        }
+        vector<int>().swap(list);    // A bitset stop holds no list memory
+    }
+    
+    // Re-encodes every stop under the new mode
+    void set_coverage_mode(CoverageMode new_mode) {
+        vector<vector<int>> lists(num_candidates);
+        for (int j = 0; j < num_candidates; j++) {
+            lists[j] = students_of(j);
+        }
+        mode = new_mode;
+        mapping.reset();
+        mapped_start = mapped_students = nullptr;
+        coverage_list.assign(num_candidates, vector<int>());
+        bitset_slot.assign(num_candidates, -1);
+        free_slots.clear();
+        AlignedWords().swap(bitset_words);
+        for (int j = 0; j < num_candidates; j++) {
+            set_coverage(j, lists[j]);
+        }
+    }
+    
+    // Start over with n students and m candidate stops (no coverage, unit
+    // costs, positions at the origin) while keeping this object's memory:
+    // posting lists, bitset rows and the other arrays keep their capacity,
+    // so an instance refilled every tick stops allocating once it has seen
+    // its largest size. The coverage mode and threads are kept.
+    void reset(int n_students, int n_candidates) {
+        num_students = n_students;
+        num_candidates = n_candidates;
+        words = (n_students + 63) / 64;
+        stride = (words + 7) / 8 * 8;
+        mapping.reset();
+        mapped_start = mapped_students = nullptr;
+        coverage_list.resize(n_candidates);
+        for (auto& list : coverage_list) list.clear();
+        coverage_count.assign(n_candidates, 0);
+        stop_costs.assign(n_candidates, 1.0);
+        bitset_slot.assign(n_candidates, -1);
+        free_slots.clear();
+        bitset_words.clear();
+        student_positions.assign(n_students, Point{0, 0});
+        stop_positions.assign(n_candidates, Point{0, 0});
+        greedy_stats = GreedyStats();
+    }
+    
+    int coverage_size(int stop_id) const {
+        return coverage_count[stop_id];
+    }
+    
+    bool is_bitset_stop(int stop_id) const {
+        return bitset_slot[stop_id] >= 0;
+    }
+    
+    // Calls visit(student) for every student of the stop, in increasing order
+    template <typename Visit>
+    void for_each_covered(int stop_id, Visit visit) const {
+        if (bitset_slot[stop_id] < 0) {
+            for (int student : list_of(stop_id)) visit(student);
+            return;
+        }
+        const uint64_t* row = bitset_row(stop_id);
+        for (int w = 0; w < words; w++) {
+            for (uint64_t bits = row[w]; bits; bits &= bits - 1) {
+                visit(w * 64 + __builtin_ctzll(bits));
+            }
+        }
+    }
+    
+    vector<int> students_of(int stop_id) const {
+        vector<int> students;
+        students.reserve(coverage_count[stop_id]);
+        for_each_covered(stop_id, [&](int student) { students.push_back(student); });
+        return students;
+    }
+    
+    // Bytes held by the coverage rows (posting lists + bitsets in use,
+    // mapped lists included)
+    size_t coverage_bytes() const {
+        size_t bytes = 0;
+        for (int j = 0; j < num_candidates; j++) {
+            bytes += bitset_slot[j] >= 0 ? stride * sizeof(uint64_t)
+                                         : (list_of(j).end() - list_of(j).begin()) * sizeof(int);
+        }
+        return bytes;
+    }
+    
+    // Evaluate candidate gains with this many threads (1 = lazy serial greedy)
+    void set_threads(int threads) {
+        if (threads <= 1) {
+            pool.reset();
+            return;
+        }
+        pool.reset(new ThreadPool(threads));
+    }
+    
+    // Counters of the last greedy_set_cover() / greedy_set_cover_parallel()
+    const GreedyStats& last_greedy_stats() const {
+        return greedy_stats;
+    }
+    
+    int threads() const {
+        return pool ? pool->size() : 1;
+    }
+    
+    int bitset_stop_count() const {
+        return count_if(bitset_slot.begin(), bitset_slot.end(), [](int slot) { return slot >= 0; });
+    }
+    
+    // Write positions, coverage (CSR) and stop costs in the binary format.
+    // False on I/O errors.
+    bool save_instance(const string& path) const {
+        vector<int> start(num_candidates + 1, 0), students;
+        for (int j = 0; j < num_candidates; j++) start[j + 1] = start[j] + coverage_count[j];
+        students.reserve(start[num_candidates]);
+        for (int j = 0; j < num_candidates; j++) {
+            for_each_covered(j, [&](int student) { students.push_back(student); });
+        }
+        bool unit_costs = all_of(stop_costs.begin(), stop_costs.end(), [](double c) { return c == 1.0; });
+        
+        uint64_t counts[4] = {(uint64_t)num_students, (uint64_t)num_candidates, students.size(), 0};
+        vector<InstanceSection> sections = {
+            {student_positions.data(), student_positions.size() * sizeof(Point)},
+            {stop_positions.data(), stop_positions.size() * sizeof(Point)},
+            {start.data(), start.size() * sizeof(int)},
+            {students.data(), students.size() * sizeof(int)},
+            {stop_costs.data(), unit_costs ? 0 : stop_costs.size() * sizeof(double)}};
+        return write_instance_file(path, BUSSTOP_MAGIC, counts, sections);
+    }
+    
+    // Map an instance file written by save_instance(). The posting lists
+    // stay in the mapping (all stops are lists until set_coverage() or
+    // set_coverage_mode()); positions, per-stop sizes and costs are copied.
+    // The offsets and ids are checked in one pass. nullptr (with a message
+    // on cerr) if the file is unusable.
+    static BusStopPlacement* load_instance(const string& path) {
+        BusStopPlacement* problem = new BusStopPlacement(0, 0);
+        if (!load_instance(path, *problem)) {
+            delete problem;
+            return nullptr;
+        }
+        return problem;
+    }
+    
+    // Same, into an existing object through reset(), so its arrays are
+    // reused. False, with the object unchanged, on errors.
+    static bool load_instance(const string& path, BusStopPlacement& problem) {
+        shared_ptr<MappedFile> file = make_shared<MappedFile>();
+        string error;
+        const InstanceHeader* header = nullptr;
+        if (!file->open(path)) {
+            error = "cannot open or map the file";
+        } else {
+            header = check_instance_header(*file, BUSSTOP_MAGIC, error);
+        }
+        
+        const Point *students_xy = nullptr, *stops_xy = nullptr;
+        const int *start = nullptr, *students = nullptr;
+        const double* costs = nullptr;
+        uint64_t n = 0, m = 0, entries = 0;
+        if (header) {
+            n = header->counts[0];
+            m = header->counts[1];
+            entries = header->counts[2];
+            if (n > (uint64_t)INT_MAX || m > (uint64_t)INT_MAX || entries > (uint64_t)INT_MAX) {
+                error = "instance too large for 32-bit ids";
+            } else if (!instance_section(*file, header, 0, n, students_xy) ||
+                       !instance_section(*file, header, 1, m, stops_xy) ||
+                       !instance_section(*file, header, 2, m + 1, start) ||
+                       !instance_section(*file, header, 3, entries, students) ||
+                       (header->section_bytes[4] != 0 &&
+                        !instance_section(*file, header, 4, m, costs))) {
+                error = "section sizes do not match the header counts";
+            } else if (start[0] != 0 || start[m] != (int)entries) {
+                error = "CSR offsets do not span the coverage entries";
+            } else {
+                for (uint64_t j = 0; j < m && error.empty(); j++) {
+                    if (start[j] > start[j + 1]) error = "CSR offsets are not sorted";
+                    for (int k = start[j]; k < start[j + 1] && error.empty(); k++) {
+                        if (students[k] < 0 || students[k] >= (int)n) error = "student id out of range";
+                        if (k > start[j] && students[k] <= students[k - 1]) error = "posting list not sorted";
+                    }
+                }
+            }
+        }
+        if (!error.empty()) {
+            cerr << "Error: cannot load " << path << ": " << error << endl;
+            return false;
+        }
+        
+        problem.reset(n, m);
+        problem.student_positions.assign(students_xy, students_xy + n);
+        problem.stop_positions.assign(stops_xy, stops_xy + m);
+        for (uint64_t j = 0; j < m; j++) {
+            problem.coverage_count[j] = start[j + 1] - start[j];
+            if (costs) problem.stop_costs[j] = costs[j];
+        }
+        problem.mapping = file;
+        problem.mapped_start = start;
+        problem.mapped_students = students;
+        return true;
+    }
+    
+    void set_student_position(int student_id, Point pos) {
+        student_positions[student_id] = pos;
+    }
+    
+    void set_stop_position(int stop_id, Point pos) {
+        stop_positions[stop_id] = pos;
+    }
+    
+    // Greedy Set Cover Algorithm (lazy evaluation)
+    //
+    // A stop's gain can only shrink as students get covered, so the last
+    // gain computed for it is an upper bound. The heap holds these bounds;
+    // the top stop is re-evaluated and taken if its fresh gain still beats
+    // every other bound, otherwise it goes back with the fresh value. Ties
+    // go to the lowest stop index, so the stops (and their order) are
+    // exactly those of greedy_set_cover_naive().
+    vector<int> greedy_set_cover() {
+        if (pool) return greedy_set_cover_parallel();
+        
+        greedy_stats = GreedyStats();
+        INSTRUMENT_START(greedy_timer);
+        vector<int> selected_stops;
+        AlignedWords covered(stride, 0);
+        int uncovered = num_students;
+        
+        // (gain bound, -stop): the max-heap pops the lowest index on ties
+        vector<pair<int, int>> bounds;
+        for (int j = 0; j < num_candidates; j++) {
+            if (coverage_count[j] > 0) bounds.push_back({coverage_count[j], -j});
+        }
+        priority_queue<pair<int, int>> heap(less<pair<int, int>>(), move(bounds));
+        
+        while (uncovered > 0) {
+            if (heap.empty()) {
+                cerr << "Error: No feasible solution - some students cannot be covered" << endl;
+                return vector<int>();
+            }
+            int stop = -heap.top().second;
+            heap.pop();
+            
+            INSTRUMENT_ADD(greedy_stats.gain_evaluations, 1);
+            INSTRUMENT_ADD(greedy_stats.elements_scanned, evaluation_size(stop));
+            int gain = newly_covered(stop, covered);
+            if (gain == 0) continue;
+            if (!heap.empty() && make_pair(gain, -stop) < heap.top()) {
+                heap.push({gain, -stop});
+                continue;
+            }
+            
+            INSTRUMENT_ADD(greedy_stats.iterations, 1);
+            selected_stops.push_back(stop);
+            INSTRUMENT_START(cover_timer);
+            cover(stop, covered);
+            INSTRUMENT_STOP(greedy_stats.cover_ms, cover_timer);
+            uncovered -= gain;
+        }
+        
+        INSTRUMENT_STOP(greedy_stats.select_ms, greedy_timer);
+        INSTRUMENT_ADD(greedy_stats.select_ms, -greedy_stats.cover_ms);
+        return selected_stops;
+    }
+    
+    // Parallel greedy: every iteration splits the candidates into one
+    // contiguous chunk per worker. A worker re-evaluates only the stops whose
+    // stale gain bound can still beat its chunk's best so far, and keeps the
+    // (gain, lowest index) maximum. Chunk winners are reduced in chunk order
+    // with a strict ">", so ties still go to the lowest index and the output
+    // is identical to the serial greedy. Without set_threads() it runs the
+    // same scan on the calling thread.
+    vector<int> greedy_set_cover_parallel() {
+        greedy_stats = GreedyStats();
+        INSTRUMENT_START(greedy_timer);
+        vector<int> selected_stops;
+        AlignedWords covered(stride, 0);
+        int uncovered = num_students;
+        int workers = threads();
+        
+        vector<int> bound(coverage_count);
+        vector<int> chunk_gain(workers), chunk_stop(workers);
+#ifdef INSTRUMENT
+        vector<long long> chunk_evaluations(workers), chunk_elements(workers);
+#endif
+        function<void(int)> evaluate = [&](int w) {
+            auto range = ThreadPool::chunk(num_candidates, workers, w);
+            int best_gain = 0, best_stop = -1;
+            for (int j = range.first; j < range.second; j++) {
+                if (bound[j] <= best_gain) continue;
+                INSTRUMENT_ADD(chunk_evaluations[w], 1);
+                INSTRUMENT_ADD(chunk_elements[w], evaluation_size(j));
+                bound[j] = newly_covered(j, covered);
+                if (bound[j] > best_gain) {
+                    best_gain = bound[j];
+                    best_stop = j;
+                }
+            }
+            chunk_gain[w] = best_gain;
+            chunk_stop[w] = best_stop;
+        };
+        
+        while (uncovered > 0) {
+            if (pool) {
+                pool->run(evaluate);
+            } else {
+                evaluate(0);
+            }
+            
+            int best_gain = 0, best_stop = -1;
+            for (int w = 0; w < workers; w++) {
+                if (chunk_gain[w] > best_gain) {
+                    best_gain = chunk_gain[w];
+                    best_stop = chunk_stop[w];
+                }
+            }
+            if (best_stop == -1) {
+                cerr << "Error: No feasible solution - some students cannot be covered" << endl;
+                return vector<int>();
+            }
+            
+            INSTRUMENT_ADD(greedy_stats.iterations, 1);
+            selected_stops.push_back(best_stop);
+            INSTRUMENT_START(cover_timer);
+            cover(best_stop, covered);
+            INSTRUMENT_STOP(greedy_stats.cover_ms, cover_timer);
+            uncovered -= best_gain;
+        }
+        
+#ifdef INSTRUMENT
+        for (int w = 0; w < workers; w++) {
+            greedy_stats.gain_evaluations += chunk_evaluations[w];
+            greedy_stats.elements_scanned += chunk_elements[w];
+        }
+#endif
+        INSTRUMENT_STOP(greedy_stats.select_ms, greedy_timer);
+        INSTRUMENT_ADD(greedy_stats.select_ms, -greedy_stats.cover_ms);
+        return selected_stops;
+    }
+    
+    // Stop costs must be positive
+    void set_stop_cost(int stop_id, double cost) {
+        stop_costs[stop_id] = cost;
+    }
+    
+    double stop_cost(int stop_id) const {
+        return stop_costs[stop_id];
+    }
+    
+    // Weighted set cover: covers every student, greedily by newly covered
+    // students per unit cost (H(n)-approximation of the cheapest cover).
+    // Empty when some student cannot be covered (with a message on cerr
+    // unless quiet).
+    vector<int> weighted_set_cover(bool quiet = false) const {
+        CoverageResult result = cost_effective_greedy(true, numeric_limits<double>::infinity(),
+                                                      num_candidates);
+        if (result.covered < num_students) {
+            if (!quiet) cerr << "Error: No feasible solution - some students cannot be covered" << endl;
+            return vector<int>();
+        }
+        return result.stops;
+    }
+    
+    // Max coverage with k stops (costs ignored): the first k picks of the
+    // unweighted greedy, a (1 - 1/e)-approximation
+    CoverageResult max_coverage(int k) const {
+        return cost_effective_greedy(false, numeric_limits<double>::infinity(), k);
+    }
+    
+    // Budgeted max coverage: the cost-effectiveness greedy restricted to
+    // affordable stops, or the best single affordable stop if that covers
+    // more ((1 - 1/e) / 2-approximation, Khuller, Moss and Naor)
+    CoverageResult budgeted_max_coverage(double budget) const {
+        CoverageResult result = cost_effective_greedy(true, budget, num_candidates);
+        
+        int best_single = -1;
+        for (int j = 0; j < num_candidates; j++) {
+            if (stop_costs[j] <= budget &&
+                (best_single < 0 || coverage_count[j] > coverage_count[best_single])) {
+                best_single = j;
+            }
+        }
+        if (best_single >= 0 && coverage_count[best_single] > result.covered) {
+            return CoverageResult{{best_single}, coverage_count[best_single], stop_costs[best_single]};
+        }
+        return result;
+    }
+    
+    // Original greedy: re-intersects every candidate with the uncovered set
+    // in every iteration, O(k * m * |S|). Kept as the reference for
+    // greedy_set_cover() in benchmark_runtime.
+    vector<int> greedy_set_cover_naive() {
+        vector<int> selected_stops;
+        set<int> uncovered_students;
+        
+        // Initialize all students as uncovered
+        for (int i = 0; i < num_students; i++) {
+            uncovered_students.insert(i);
+        }
+        
+        while (!uncovered_students.empty()) {
+            int best_stop = -1;
+            set<int> best_coverage;
+            
+            // Find stop that covers most uncovered students
+            for (int j = 0; j < num_candidates; j++) {
+                set<int> new_coverage;
+                vector<int> students = students_of(j);
+                set_intersection(students.begin(), students.end(),
+                               uncovered_students.begin(), uncovered_students.end(),
+                               inserter(new_coverage, new_coverage.begin()));
+                
+                if (new_coverage.size() > best_coverage.size()) {
+                    best_coverage = new_coverage;
+                    best_stop = j;
+                }
+            }
+            
+            // If no stop covers any remaining students, problem is infeasible
+            if (best_stop == -1 || best_coverage.empty()) {
+                cerr << "Error: No feasible solution - some students cannot be covered" << endl;
+                return vector<int>();
+            }
+            
+            // Add best stop to solution
+            selected_stops.push_back(best_stop);
+            
+            // Remove covered students from uncovered set
+            for (int student : best_coverage) {
+                uncovered_students.erase(student);
+            }
+        }
+        
+        return selected_stops;
+    }
+    
+    // Verify solution covers all students
+    bool verify_solution(const vector<int>& selected_stops) {
+        AlignedWords covered(stride, 0);
+        for (int stop_id : selected_stops) {
+            cover(stop_id, covered);
+        }
+        return count_bits(covered.data(), words) == num_students;
+    }
+    
+    void print_stats(const vector<int>& solution) {
+        cout << "Solution Statistics:" << '\n';
+        cout << "  Students: " << num_students << '\n';
+        cout << "  Candidate stops: " << num_candidates << '\n';
+        cout << "  Stops selected: " << solution.size() << '\n';
+        cout << "  Coverage verified: " << (verify_solution(solution) ? "Yes" : "No") << '\n';
+    }
+    
+    // Sections of x,y rows; the students and stops are handed to a
+    // background writer, so large dumps cost one buffered pass
+    void save_visualization_data(const vector<int>& solution, const string& filename) {
+        ResultWriter out(filename, {"x", "y"}, RESULT_CSV, false);
+        
+        // Save students
+        out.text("STUDENTS");
+        for (int i = 0; i < num_students; i++) {
+            out << student_positions[i].x << student_positions[i].y;
+            out.end_row();
+        }
+        
+        // Save selected stops
+        out.text("SELECTED_STOPS");
+        for (int stop_id : solution) {
+            out << stop_positions[stop_id].x << stop_positions[stop_id].y;
+            out.end_row();
+        }
+        
+        // Save unselected stops
+        out.text("UNSELECTED_STOPS");
+        vector<char> selected(num_candidates, 0);
+        for (int stop_id : solution) selected[stop_id] = 1;
+        for (int i = 0; i < num_candidates; i++) {
+            if (!selected[i]) {
+                out << stop_positions[i].x << stop_positions[i].y;
+                out.end_row();
+            }
+        }
+        
+        out.close();
+    }
+};
+
+// Post-greedy improvement of a set cover by local search
+//
+// Per student it keeps how many selected stops cover it (count) and the XOR
+// of their ids (owner), so when count == 1 the owner is the one stop that
+// covers it alone. Each selected stop keeps how many of its students it
+// covers alone (alone_count); a stop with alone_count == 0 is redundant.
+// All counters are updated incrementally in O(|stop|) per add/remove.
+//
+// Moves, applied only when they lower the total stop cost:
+// - redundancy removal: drop a selected stop that covers nobody alone,
+// - 1-swap: replace a selected stop a by an unselected stop c covering all
+//   students a covers alone (pays off with stop costs),
+// - 2-for-1: the same swap, after which other selected stops became
+//   redundant and are dropped too.
+//
+// run() is anytime: it stops at the time limit with a valid cover in
+// solution() and can be called again to continue.
+class CoverLocalSearch {
+private:
+    const BusStopPlacement& problem;
+    int num_students, num_candidates;
+    
+    // stop -> students and student -> stops, both CSR
+    vector<int> stop_start, stop_students;
+    vector<int> student_start, student_stops;
+    
+    vector<char> selected;
+    vector<int> count, owner, alone_count;
+    vector<int> stamp;
+    int epoch;
+    double total_cost;
+    bool converged;
+    long long applied_moves;
+    
+    void add(int stop) {
+        selected[stop] = 1;
+        alone_count[stop] = 0;
+        total_cost += problem.stop_cost(stop);
+        for (int k = stop_start[stop]; k < stop_start[stop + 1]; k++) {
+            int student = stop_students[k];
+            if (count[student] == 1) alone_count[owner[student]]--;
+            count[student]++;
+            owner[student] ^= stop;
+            if (count[student] == 1) alone_count[stop]++;
+        }
+    }
+    
+    void remove(int stop) {
+        selected[stop] = 0;
+        total_cost -= problem.stop_cost(stop);
+        for (int k = stop_start[stop]; k < stop_start[stop + 1]; k++) {
+            int student = stop_students[k];
+            count[student]--;
+            owner[student] ^= stop;
+            if (count[student] == 1) alone_count[owner[student]]++;
+        }
+        alone_count[stop] = 0;
+    }
+    
+    // Drops redundant selected stops, most expensive first
+    bool remove_redundant() {
+        vector<int> redundant;
+        for (int s = 0; s < num_candidates; s++) {
+            if (selected[s] && alone_count[s] == 0) redundant.push_back(s);
+        }
+        stable_sort(redundant.begin(), redundant.end(), [&](int a, int b) {
+            return problem.stop_cost(a) > problem.stop_cost(b);
+        });
+        bool changed = false;
+        for (int s : redundant) {
+            if (alone_count[s] == 0) {
+                remove(s);
+                applied_moves++;
+                changed = true;
+            }
+        }
+        return changed;
+    }
+    
+    // Tries to swap selected stop a for one unselected stop (1-swap or
+    // 2-for-1); keeps the first move that lowers the cost
+    bool try_swap(int a) {
+        // A student only a covers; every replacement must cover it
+        int pivot = -1;
+        for (int k = stop_start[a]; k < stop_start[a + 1] && pivot < 0; k++) {
+            if (count[stop_students[k]] == 1) pivot = stop_students[k];
+        }
+        if (pivot < 0) return false;
+        
+        for (int p = student_start[pivot]; p < student_start[pivot + 1]; p++) {
+            int c = student_stops[p];
+            if (selected[c]) continue;
+            
+            // c must cover every student a covers alone
+            epoch++;
+            for (int k = stop_start[c]; k < stop_start[c + 1]; k++) stamp[stop_students[k]] = epoch;
+            bool covers_all = true;
+            for (int k = stop_start[a]; k < stop_start[a + 1] && covers_all; k++) {
+                int student = stop_students[k];
+                if (count[student] == 1 && stamp[student] != epoch) covers_all = false;
+            }
+            if (!covers_all) continue;
+            
+            double before = total_cost;
+            add(c);
+            remove(a);
+            
+            // Stops that now cover nobody alone share students with c
+            vector<int> dropped;
+            for (int k = stop_start[c]; k < stop_start[c + 1]; k++) {
+                int student = stop_students[k];
+                for (int q = student_start[student]; q < student_start[student + 1]; q++) {
+                    int b = student_stops[q];
+                    if (b != c && selected[b] && alone_count[b] == 0) {
+                        remove(b);
+                        dropped.push_back(b);
+                    }
+                }
+            }
+            
+            if (total_cost < before - 1e-9) {
+                applied_moves++;
+                return true;
+            }
+            for (int b : dropped) add(b);
+            add(a);
+            remove(c);
+        }
+        return false;
+    }
+    
+public:
+    CoverLocalSearch(const BusStopPlacement& problem, const vector<int>& initial)
+        : problem(problem), num_students(problem.num_students),
+          num_candidates(problem.num_candidates), epoch(0), total_cost(0),
+          converged(false), applied_moves(0) {
+        stop_start.assign(num_candidates + 1, 0);
+        student_start.assign(num_students + 1, 0);
+        for (int s = 0; s < num_candidates; s++) {
+            stop_start[s + 1] = stop_start[s] + problem.coverage_size(s);
+            problem.for_each_covered(s, [&](int student) { student_start[student + 1]++; });
+        }
+        for (int i = 0; i < num_students; i++) {
+            student_start[i + 1] += student_start[i];
+        }
+        stop_students.resize(stop_start[num_candidates]);
+        student_stops.resize(stop_start[num_candidates]);
+        vector<int> fill_pos(student_start.begin(), student_start.end() - 1);
+        for (int s = 0; s < num_candidates; s++) {
+            int k = stop_start[s];
+            problem.for_each_covered(s, [&](int student) {
+                stop_students[k++] = student;
+                student_stops[fill_pos[student]++] = s;
+            });
+        }
+        
+        selected.assign(num_candidates, 0);
+        count.assign(num_students, 0);
+        owner.assign(num_students, 0);
+        alone_count.assign(num_candidates, 0);
+        stamp.assign(num_students, 0);
+        for (int s : initial) {
+            if (!selected[s]) add(s);
+        }
+    }
+    
+    // Improves until a local optimum (returns true) or time_limit_ms
+    bool run(double time_limit_ms) {
+        auto deadline = high_resolution_clock::now() +
+                        duration_cast<high_resolution_clock::duration>(duration<double, milli>(time_limit_ms));
+        
+        while (!converged) {
+            bool improved = remove_redundant();
+            for (int a = 0; a < num_candidates; a++) {
+                if (high_resolution_clock::now() >= deadline) return false;
+                if (selected[a] && try_swap(a)) improved = true;
+            }
+            converged = !improved && !remove_redundant();
+        }
+        return true;
+    }
+    
+    vector<int> solution() const {
+        vector<int> stops;
+        for (int s = 0; s < num_candidates; s++) {
+            if (selected[s]) stops.push_back(s);
+        }
+        return stops;
+    }
+    
+    double cost() const { return total_cost; }
+    long long moves() const { return applied_moves; }
+};
+
+// Result of ExactSetCover::solve()
+struct ExactResult {
+    vector<int> stops;     // Best cover found
+    double cost;           // Its total stop cost
+    double lower_bound;    // Proven lower bound on the optimal cost
+    bool optimal;          // Search finished within the time limit
+    long long nodes;
+    
+    // Relative distance between the best cover and the bound (0 = optimal)
+    double gap() const {
+        return cost > 0 ? (cost - lower_bound) / cost : 0.0;
+    }
+};
+
+// Branch-and-bound set cover solver for small-to-medium instances
+//
+// Root reductions: stops whose students are a subset of a no more expensive
+// stop are dropped (dominated stops), then students whose stop set contains
+// another student's stop set are dropped (covering the other one covers
+// them too); both are repeated until nothing changes.
+//
+// Search: branch on the uncovered student with the fewest available stops,
+// trying each of its stops in order of gain per cost; a stop tried in one
+// branch is excluded from its later siblings. Nodes are pruned with the
+// greedy dual bound: students in order of increasing degree get
+// y_i = min slack over their available stops, which is a feasible LP dual
+// solution, so the sum of y is a lower bound on the remaining cost. The
+// incumbent starts from greedy + local search.
+class ExactSetCover {
+private:
+    const BusStopPlacement& problem;
+    int num_students, num_candidates;
+    int words;
+    
+    vector<int> stops, students;          // Kept after the root reductions
+    vector<AlignedWords> rows;            // Bitset of each kept stop over all students
+    vector<vector<int>> stops_of;         // Student -> kept stops covering it
+    vector<int> student_order;            // Kept students by increasing degree
+    
+    vector<char> excluded, chosen;
+    vector<double> slack;
+    vector<int> slack_stamp;
+    int epoch;
+    bool integral_costs;
+    
+    vector<int> path;
+    vector<int> best_stops;
+    double best_cost;
+    long long nodes;
+    bool timed_out;
+    high_resolution_clock::time_point deadline;
+    
+    bool is_covered(const AlignedWords& covered, int student) const {
+        return covered[student >> 6] >> (student & 63) & 1;
+    }
+    
+    // Greedy dual bound on the cost of covering the uncovered kept students;
+    // -1 when one of them has no available stop left
+    double dual_bound(const AlignedWords& covered) {
+        epoch++;
+        double bound = 0;
+        for (int student : student_order) {
+            if (is_covered(covered, student)) continue;
+            double y = numeric_limits<double>::infinity();
+            for (int s : stops_of[student]) {
+                if (excluded[s]) continue;
+                if (slack_stamp[s] != epoch) {
+                    slack_stamp[s] = epoch;
+                    slack[s] = problem.stop_cost(stops[s]);
+                }
+                y = min(y, slack[s]);
+            }
+            if (y == numeric_limits<double>::infinity()) return -1;
+            for (int s : stops_of[student]) {
+                if (!excluded[s]) slack[s] -= y;
+            }
+            bound += y;
+        }
+        return bound;
+    }
+    
+    bool prune(double cost, double bound) const {
+        double total = cost + bound;
+        if (integral_costs) total = ceil(total - 1e-9);
+        return total >= best_cost - 1e-9;
+    }
+    
+    void branch(const AlignedWords& covered, double cost) {
+        if (timed_out) return;
+        if ((++nodes & 255) == 0 && high_resolution_clock::now() >= deadline) {
+            timed_out = true;
+            return;
+        }
+        
+        double bound = dual_bound(covered);
+        if (bound < 0 || prune(cost, bound)) return;
+        
+        // Uncovered student with the fewest available stops
+        int pick = -1, pick_degree = INT_MAX;
+        for (int student : students) {
+            if (is_covered(covered, student)) continue;
+            int degree = 0;
+            for (int s : stops_of[student]) {
+                if (!excluded[s]) degree++;
+            }
+            if (degree < pick_degree) {
+                pick = student;
+                pick_degree = degree;
+            }
+        }
+        if (pick < 0) {
+            best_cost = cost;
+            best_stops = path;
+            return;
+        }
+        
+        vector<pair<double, int>> options;
+        for (int s : stops_of[pick]) {
+            if (excluded[s]) continue;
+            int gain = count_and_not(rows[s].data(), covered.data(), words);
+            options.push_back({-gain / problem.stop_cost(stops[s]), s});
+        }
+        sort(options.begin(), options.end());
+        
+        AlignedWords next(covered.size());
+        vector<int> tried;
+        for (auto& option : options) {
+            int s = option.second;
+            copy(covered.begin(), covered.end(), next.begin());
+            or_into(next.data(), rows[s].data(), words);
+            path.push_back(stops[s]);
+            branch(next, cost + problem.stop_cost(stops[s]));
+            path.pop_back();
+            if (timed_out) break;
+            excluded[s] = 1;
+            tried.push_back(s);
+        }
+        for (int s : tried) excluded[s] = 0;
+    }
+    
+    // Dominated stops and students, repeated until nothing changes
+    void reduce() {
+        vector<int> all_stops;
+        for (int s = 0; s < num_candidates; s++) {
+            if (problem.coverage_size(s) > 0) all_stops.push_back(s);
+        }
+        vector<AlignedWords> all_rows(num_candidates);
+        for (int s : all_stops) {
+            all_rows[s].assign(words, 0);
+            problem.for_each_covered(s, [&](int student) {
+                all_rows[s][student >> 6] |= 1ULL << (student & 63);
+            });
+        }
+        
+        vector<char> stop_alive(num_candidates, 0), student_alive(num_students, 1);
+        for (int s : all_stops) stop_alive[s] = 1;
+        AlignedWords alive_mask(words, 0);
+        for (int i = 0; i < num_students; i++) alive_mask[i >> 6] |= 1ULL << (i & 63);
+        
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            
+            // Stop a is dominated by b when a's live students are all b's
+            // and b costs no more (ties keep the lower index)
+            for (int a : all_stops) {
+                if (!stop_alive[a]) continue;
+                for (int b : all_stops) {
+                    if (b == a || !stop_alive[b]) continue;
+                    double ca = problem.stop_cost(a), cb = problem.stop_cost(b);
+                    if (cb > ca || (cb == ca && b > a)) continue;
+                    bool subset = true;
+                    for (int w = 0; w < words && subset; w++) {
+                        if (all_rows[a][w] & alive_mask[w] & ~all_rows[b][w]) subset = false;
+                    }
+                    if (subset) {
+                        stop_alive[a] = 0;
+                        changed = true;
+                        break;
+                    }
+                }
+            }
+            
+            // Student i is dominated by j when every live stop of j covers i
+            vector<vector<int>> live_stops(num_students);
+            for (int s : all_stops) {
+                if (!stop_alive[s]) continue;
+                problem.for_each_covered(s, [&](int student) {
+                    if (student_alive[student]) live_stops[student].push_back(s);
+                });
+            }
+            for (int i = 0; i < num_students; i++) {
+                if (!student_alive[i] || live_stops[i].empty()) continue;
+                for (int j = 0; j < num_students; j++) {
+                    if (j == i || !student_alive[j] || live_stops[j].size() > live_stops[i].size()) continue;
+                    if (live_stops[j].size() == live_stops[i].size() && j > i) continue;
+                    if (includes(live_stops[i].begin(), live_stops[i].end(),
+                                 live_stops[j].begin(), live_stops[j].end())) {
+                        student_alive[i] = 0;
+                        alive_mask[i >> 6] &= ~(1ULL << (i & 63));
+                        changed = true;
+                        break;
+                    }
+                }
+            }
+        }
+        
+        vector<int> local_id(num_candidates, -1);
+        for (int s : all_stops) {
+            if (!stop_alive[s]) continue;
+            local_id[s] = stops.size();
+            stops.push_back(s);
+            rows.push_back(all_rows[s]);
+        }
+        stops_of.assign(num_students, vector<int>());
+        for (int k = 0; k < (int)stops.size(); k++) {
+            problem.for_each_covered(stops[k], [&](int student) {
+                if (student_alive[student]) stops_of[student].push_back(k);
+            });
+        }
+        for (int i = 0; i < num_students; i++) {
+            if (student_alive[i]) students.push_back(i);
+        }
+        student_order = students;
+        stable_sort(student_order.begin(), student_order.end(), [&](int a, int b) {
+            return stops_of[a].size() < stops_of[b].size();
+        });
+    }
+    
+public:
+    ExactSetCover(const BusStopPlacement& problem)
+        : problem(problem), num_students(problem.num_students),
+          num_candidates(problem.num_candidates), words((problem.num_students + 63) / 64),
+          epoch(0), best_cost(0), nodes(0), timed_out(false) {
+        integral_costs = true;
+        for (int s = 0; s < num_candidates; s++) {
+            double c = problem.stop_cost(s);
+            if (c != floor(c)) integral_costs = false;
+        }
+        reduce();
+        excluded.assign(stops.size(), 0);
+        slack.assign(stops.size(), 0);
+        slack_stamp.assign(stops.size(), 0);
+    }
+    
+    // Kept after the root reductions
+    int reduced_stops() const { return stops.size(); }
+    int reduced_students() const { return students.size(); }
+    
+    // Best cover within time_limit_ms, with a proven lower bound. An
+    // infeasible instance gives an empty cover with infinite cost.
+    ExactResult solve(double time_limit_ms) {
+        deadline = high_resolution_clock::now() +
+                   duration_cast<high_resolution_clock::duration>(duration<double, milli>(time_limit_ms));
+        nodes = 0;
+        timed_out = false;
+        
+        // Incumbent: greedy cover improved by local search (an infeasible
+        // instance is reported through the result, not on cerr)
+        vector<int> greedy = problem.weighted_set_cover(true);
+        best_cost = numeric_limits<double>::infinity();
+        best_stops.clear();
+        if (!greedy.empty()) {
+            CoverLocalSearch search(problem, greedy);
+            search.run(time_limit_ms / 10);
+            best_stops = search.solution();
+            best_cost = search.cost();
+        }
+        
+        AlignedWords covered(words, 0);
+        double root_bound = dual_bound(covered);
+        if (root_bound < 0) {
+            return ExactResult{vector<int>(), numeric_limits<double>::infinity(),
+                               numeric_limits<double>::infinity(), true, 0};
+        }
+        if (integral_costs) root_bound = ceil(root_bound - 1e-9);
+        
+        branch(covered, 0.0);
+        
+        ExactResult result;
+        result.stops = best_stops;
+        sort(result.stops.begin(), result.stops.end());
+        result.cost = best_cost;
+        result.optimal = !timed_out;
+        result.lower_bound = timed_out ? min(root_bound, best_cost) : best_cost;
+        result.nodes = nodes;
+        return result;
+    }
+};
+
+// Kernelization for set cover: reduce, split into components, solve each
+// component on its own (in parallel) and map the stops back
+//
+// Reductions, repeated until nothing changes:
+// - forced stops: a student left with one stop forces that stop, and the
+//   students it covers leave the instance,
+// - dominated stops: a stop whose remaining students are a subset of a no
+//   more expensive stop's; the candidates are the stops of its student with
+//   the fewest stops, so the check is exact,
+// - dominated students: a student whose stops include all stops of another
+//   one is covered whenever that one is; the candidates are the students of
+//   the dominating student's smallest stop, so this check is exact too.
+// After the first pass only stops that lost a student and students that
+// lost a stop are re-examined, since nothing else can start dominating or
+// being dominated.
+// The remaining stops are then split into connected components (stops
+// sharing a student) with a union-find.
+class SetCoverKernel {
+public:
+    // Solves one component given as its own BusStopPlacement (local ids)
+    typedef function<vector<int>(BusStopPlacement&)> ComponentSolver;
+    
+private:
+    const BusStopPlacement& problem;
+    int num_students, num_candidates;
+    
+    vector<int> stop_start, stop_students;
+    vector<int> student_start, student_stops;
+    
+    vector<char> stop_alive, student_alive;
+    vector<int> live_size, live_degree;
+    vector<char> stop_dirty, student_dirty;
+    bool infeasible;
+    
+    vector<int> forced;
+    vector<vector<int>> component_stops, component_students;
+    int dominated_stop_count, dominated_student_count;
+    
+    void drop_student(int student) {
+        student_alive[student] = 0;
+        for (int k = student_start[student]; k < student_start[student + 1]; k++) {
+            live_size[student_stops[k]]--;
+            stop_dirty[student_stops[k]] = 1;
+        }
+    }
+    
+    void drop_stop(int stop) {
+        stop_alive[stop] = 0;
+        for (int k = stop_start[stop]; k < stop_start[stop + 1]; k++) {
+            int student = stop_students[k];
+            if (student_alive[student]) {
+                live_degree[student]--;
+                student_dirty[student] = 1;
+            }
+        }
+    }
+    
+    void force(int stop) {
+        forced.push_back(stop);
+        drop_stop(stop);
+        for (int k = stop_start[stop]; k < stop_start[stop + 1]; k++) {
+            if (student_alive[stop_students[k]]) drop_student(stop_students[k]);
+        }
+    }
+    
+    bool reduce_forced() {
+        bool changed = false;
+        for (int i = 0; i < num_students; i++) {
+            if (!student_alive[i]) continue;
+            if (live_degree[i] == 0) {
+                infeasible = true;
+                return false;
+            }
+            if (live_degree[i] > 1) continue;
+            for (int k = student_start[i]; k < student_start[i + 1]; k++) {
+                if (stop_alive[student_stops[k]]) {
+                    force(student_stops[k]);
+                    changed = true;
+                    break;
+                }
+            }
+        }
+        for (int s = 0; s < num_candidates; s++) {
+            if (stop_alive[s] && live_size[s] == 0) drop_stop(s);
+        }
+        return changed;
+    }
+    
+    bool reduce_dominated_stops() {
+        bool changed = false;
+        for (int a = 0; a < num_candidates; a++) {
+            if (!stop_alive[a] || !stop_dirty[a]) continue;
+            stop_dirty[a] = 0;
+            int rarest = -1;
+            for (int k = stop_start[a]; k < stop_start[a + 1]; k++) {
+                int student = stop_students[k];
+                if (student_alive[student] && (rarest < 0 || live_degree[student] < live_degree[rarest])) {
+                    rarest = student;
+                }
+            }
+            if (rarest < 0) {
+                drop_stop(a);
+                changed = true;
+                continue;
+            }
+            for (int q = student_start[rarest]; q < student_start[rarest + 1]; q++) {
+                int b = student_stops[q];
+                if (b == a || !stop_alive[b] || live_size[b] < live_size[a]) continue;
+                double ca = problem.stop_cost(a), cb = problem.stop_cost(b);
+                if (cb > ca || (cb == ca && live_size[b] == live_size[a] && b > a)) continue;
+                
+                // Student stop lists are sorted, so membership is a binary
+                // search and most candidates fail on their first miss
+                bool subset = true;
+                for (int k = stop_start[a]; k < stop_start[a + 1] && subset; k++) {
+                    int student = stop_students[k];
+                    if (student_alive[student] &&
+                        !binary_search(student_stops.begin() + student_start[student],
+                                       student_stops.begin() + student_start[student + 1], b)) {
+                        subset = false;
+                    }
+                }
+                if (subset) {
+                    drop_stop(a);
+                    dominated_stop_count++;
+                    changed = true;
+                    break;
+                }
+            }
+        }
+        return changed;
+    }
+    
+    // Student j drops every student whose stops include all of j's
+    bool reduce_dominated_students() {
+        bool changed = false;
+        for (int j = 0; j < num_students; j++) {
+            if (!student_alive[j] || !student_dirty[j]) continue;
+            student_dirty[j] = 0;
+            int smallest = -1;
+            for (int k = student_start[j]; k < student_start[j + 1]; k++) {
+                int s = student_stops[k];
+                if (stop_alive[s] && (smallest < 0 || live_size[s] < live_size[smallest])) smallest = s;
+            }
+            if (smallest < 0) continue;    // Left for reduce_forced() to report
+            
+            for (int q = stop_start[smallest]; q < stop_start[smallest + 1]; q++) {
+                int i = stop_students[q];
+                if (i == j || !student_alive[i] || live_degree[i] < live_degree[j]) continue;
+                if (live_degree[i] == live_degree[j] && i < j) continue;
+                
+                // Stop lists are sorted by student, as student lists are by stop
+                bool subset = true;
+                for (int k = student_start[j]; k < student_start[j + 1] && subset; k++) {
+                    int s = student_stops[k];
+                    if (stop_alive[s] &&
+                        !binary_search(stop_students.begin() + stop_start[s],
+                                       stop_students.begin() + stop_start[s + 1], i)) {
+                        subset = false;
+                    }
+                }
+                if (subset) {
+                    drop_student(i);
+                    dominated_student_count++;
+                    changed = true;
+                }
+            }
+        }
+        return changed;
+    }
+    
+    int find(vector<int>& parent, int x) {
+        while (parent[x] != x) {
+            parent[x] = parent[parent[x]];
+            x = parent[x];
+        }
+        return x;
+    }
+    
+    void split_components() {
+        vector<int> parent(num_candidates);
+        for (int s = 0; s < num_candidates; s++) parent[s] = s;
+        for (int i = 0; i < num_students; i++) {
+            if (!student_alive[i]) continue;
+            int first = -1;
+            for (int k = student_start[i]; k < student_start[i + 1]; k++) {
+                int s = student_stops[k];
+                if (!stop_alive[s]) continue;
+                if (first < 0) {
+                    first = find(parent, s);
+                } else {
+                    parent[find(parent, s)] = first;
+                }
+            }
+        }
+        
+        vector<int> component_of(num_candidates, -1);
+        for (int s = 0; s < num_candidates; s++) {
+            if (!stop_alive[s]) continue;
+            int root = find(parent, s);
+            if (component_of[root] < 0) {
+                component_of[root] = component_stops.size();
+                component_stops.push_back(vector<int>());
+                component_students.push_back(vector<int>());
+            }
+            component_stops[component_of[root]].push_back(s);
+        }
+        for (int i = 0; i < num_students; i++) {
+            if (!student_alive[i]) continue;
+            for (int k = student_start[i]; k < student_start[i + 1]; k++) {
+                if (stop_alive[student_stops[k]]) {
+                    component_students[component_of[find(parent, student_stops[k])]].push_back(i);
+                    break;
+                }
+            }
+        }
+    }
+    
+    // Component c as a standalone instance with local student/stop ids
+    BusStopPlacement* component_instance(int c, vector<int>& local_student) const {
+        const vector<int>& stops = component_stops[c];
+        const vector<int>& students = component_students[c];
+        for (int k = 0; k < (int)students.size(); k++) local_student[students[k]] = k;
+        
+        BusStopPlacement* sub = new BusStopPlacement(students.size(), stops.size());
+        vector<int> covered;
+        for (int k = 0; k < (int)stops.size(); k++) {
+            covered.clear();
+            for (int q = stop_start[stops[k]]; q < stop_start[stops[k] + 1]; q++) {
+                int student = stop_students[q];
+                if (student_alive[student]) covered.push_back(local_student[student]);
+            }
+            sub->set_coverage(k, covered);
+            sub->set_stop_cost(k, problem.stop_cost(stops[k]));
+        }
+        return sub;
+    }
     
 public:
-    BusStopPlacement(int n_students, int n_candidates)
-        : num_students(n_students), num_candidates(n_candidates) {
-        coverage.resize(n_candidates);
-        student_positions.resize(n_students);
-        stop_positions.resize(n_candidates);
+    SetCoverKernel(const BusStopPlacement& problem)
+        : problem(problem), num_students(problem.num_students),
+          num_candidates(problem.num_candidates), infeasible(false),
+          dominated_stop_count(0), dominated_student_count(0) {
+        stop_start.assign(num_candidates + 1, 0);
+        student_start.assign(num_students + 1, 0);
+        for (int s = 0; s < num_candidates; s++) {
+            stop_start[s + 1] = stop_start[s] + problem.coverage_size(s);
+            problem.for_each_covered(s, [&](int student) { student_start[student + 1]++; });
+        }
+        for (int i = 0; i < num_students; i++) {
+            student_start[i + 1] += student_start[i];
+        }
+        stop_students.resize(stop_start[num_candidates]);
+        student_stops.resize(stop_start[num_candidates]);
+        vector<int> fill_pos(student_start.begin(), student_start.end() - 1);
+        for (int s = 0; s < num_candidates; s++) {
+            int k = stop_start[s];
+            problem.for_each_covered(s, [&](int student) {
+                stop_students[k++] = student;
+                student_stops[fill_pos[student]++] = s;
+            });
+        }
+        
+        stop_alive.assign(num_candidates, 1);
+        student_alive.assign(num_students, 1);
+        live_size.resize(num_candidates);
+        live_degree.resize(num_students);
+        for (int s = 0; s < num_candidates; s++) live_size[s] = problem.coverage_size(s);
+        for (int i = 0; i < num_students; i++) live_degree[i] = student_start[i + 1] - student_start[i];
+        stop_dirty.assign(num_candidates, 1);
+        student_dirty.assign(num_students, 1);
+        
+        bool changed = true;
+        while (changed && !infeasible) {
+            changed = reduce_forced();
+            if (infeasible) break;
+            changed = reduce_dominated_stops() || changed;
+            changed = reduce_dominated_students() || changed;
+        }
+        if (!infeasible) split_components();
     }
     
-    void set_coverage(int stop_id, const set<int>& covered_students) {
-        coverage[stop_id] = covered_students;
-    }
+    bool is_infeasible() const { return infeasible; }
+    int forced_stops() const { return forced.size(); }
+    int dominated_stops() const { return dominated_stop_count; }
+    int dominated_students() const { return dominated_student_count; }
+    int components() const { return component_stops.size(); }
     
-    void set_student_position(int student_id, Point pos) {
-        student_positions[student_id] = pos;
+    int kernel_stops() const {
+        return count(stop_alive.begin(), stop_alive.end(), 1);
     }
     
-    void set_stop_position(int stop_id, Point pos) {
-        stop_positions[stop_id] = pos;
+    int kernel_students() const {
+        return count(student_alive.begin(), student_alive.end(), 1);
     }
     
-    // Greedy Set Cover Algorithm
-    vector<int> greedy_set_cover() {
-        vector<int> selected_stops;
-        set<int> uncovered_students;
-        
-        // Initialize all students as uncovered
-        for (int i = 0; i < num_students; i++) {
-            uncovered_students.insert(i);
+    // Forced stops plus every component's solution, in original stop ids.
+    // Components are handed out largest first to `threads` workers; empty
+    // when the instance or a component has no cover.
+    vector<int> solve(const ComponentSolver& solver, int threads = 1) const {
+        if (infeasible) {
+            cerr << "Error: No feasible solution - some students cannot be covered" << endl;
+            return vector<int>();
         }
+        int count = component_stops.size();
+        vector<int> order(count);
+        for (int c = 0; c < count; c++) order[c] = c;
+        sort(order.begin(), order.end(), [&](int a, int b) {
+            return component_stops[a].size() > component_stops[b].size();
+        });
         
-        while (!uncovered_students.empty()) {
-            int best_stop = -1;
-            set<int> best_coverage;
-            
-            // Find stop that covers most uncovered students
-            for (int j = 0; j < num_candidates; j++) {
-                set<int> new_coverage;
-                set_intersection(coverage[j].begin(), coverage[j].end(),
-                               uncovered_students.begin(), uncovered_students.end(),
-                               inserter(new_coverage, new_coverage.begin()));
-                
-                if (new_coverage.size() > best_coverage.size()) {
-                    best_coverage = new_coverage;
-                    best_stop = j;
+        vector<vector<int>> solutions(count);
+        vector<char> failed(count, 0);
+        atomic<int> next(0);
+        ThreadPool pool(max(1, min(threads, count)));
+        pool.run([&](int) {
+            vector<int> local_student(num_students);
+            for (int k = next++; k < count; k = next++) {
+                int c = order[k];
+                BusStopPlacement* sub = component_instance(c, local_student);
+                for (int local : solver(*sub)) {
+                    solutions[c].push_back(component_stops[c][local]);
                 }
+                failed[c] = solutions[c].empty();
+                delete sub;
             }
-            
-            // If no stop covers any remaining students, problem is infeasible
-            if (best_stop == -1 || best_coverage.empty()) {
-                cerr << "Error: No feasible solution - some students cannot be covered" << endl;
-                return vector<int>();
-            }
-            
-            // Add best stop to solution
-            selected_stops.push_back(best_stop);
-            
-            // Remove covered students from uncovered set
-            for (int student : best_coverage) {
-                uncovered_students.erase(student);
-            }
-        }
+        });
         
-        return selected_stops;
+        vector<int> stops = forced;
+        for (int c = 0; c < count; c++) {
+            if (failed[c]) return vector<int>();
+            stops.insert(stops.end(), solutions[c].begin(), solutions[c].end());
+        }
+        return stops;
     }
+};
+
+// Students bucketed into a uniform grid of square cells (side >= the walking
+// distance, enlarged to keep O(n) cells), stored cell by cell in SoA x/y
+// arrays. The cells of one grid row overlapping a query disk are contiguous,
+// so each row is one straight squared-distance loop the compiler vectorizes.
+class StudentGrid {
+private:
+    double min_x, min_y, cell;
+    int cols, rows;
+    vector<int> cell_start;
+    vector<int> ids;          // Student id of each slot
+    vector<double> xs, ys;    // Coordinates of each slot
+    vector<unsigned char> inside;
     
-    // Verify solution covers all students
-    bool verify_solution(const vector<int>& selected_stops) {
-        set<int> covered;
-        for (int stop_id : selected_stops) {
-            covered.insert(coverage[stop_id].begin(), coverage[stop_id].end());
-        }
-        return covered.size() == num_students;
+    int column(double x) const {
+        return max(0, min(cols - 1, (int)((x - min_x) / cell)));
     }
     
-    void print_stats(const vector<int>& solution) {
-        cout << "Solution Statistics:" << endl;
-        cout << "  Students: " << num_students << endl;
-        cout << "  Candidate stops: " << num_candidates << endl;
-        cout << "  Stops selected: " << solution.size() << endl;
-        cout << "  Coverage verified: " << (verify_solution(solution) ? "Yes" : "No") << endl;
+    int row(double y) const {
+        return max(0, min(rows - 1, (int)((y - min_y) / cell)));
     }
     
-    void save_visualization_data(const vector<int>& solution, const string& filename) {
-        ofstream out(filename);
-        
-        // Save students
-        out << "STUDENTS" << endl;
-        for (int i = 0; i < num_students; i++) {
-            out << student_positions[i].x << "," << student_positions[i].y << endl;
+public:
+    StudentGrid(const vector<Point>& students, double radius)
+        : min_x(0), min_y(0), cell(1), cols(1), rows(1) {
+        int n = students.size();
+        if (n > 0) {
+            double max_x = students[0].x, max_y = students[0].y;
+            min_x = max_x;
+            min_y = max_y;
+            for (const Point& p : students) {
+                min_x = min(min_x, p.x);
+                min_y = min(min_y, p.y);
+                max_x = max(max_x, p.x);
+                max_y = max(max_y, p.y);
+            }
+            double width = max_x - min_x, height = max_y - min_y;
+            cell = max({radius, sqrt(max(width * height, 1e-12) / n), max(width, height) / n});
+            cols = (int)(width / cell) + 1;
+            rows = (int)(height / cell) + 1;
         }
         
-        // Save selected stops
-        out << "SELECTED_STOPS" << endl;
-        for (int stop_id : solution) {
-            out << stop_positions[stop_id].x << "," << stop_positions[stop_id].y << endl;
+        // Counting sort by cell; ids stay increasing within a cell
+        cell_start.assign((size_t)cols * rows + 1, 0);
+        vector<int> cell_of(n);
+        for (int i = 0; i < n; i++) {
+            cell_of[i] = row(students[i].y) * cols + column(students[i].x);
+            cell_start[cell_of[i] + 1]++;
         }
+        for (size_t c = 0; c + 1 < cell_start.size(); c++) {
+            cell_start[c + 1] += cell_start[c];
+        }
+        ids.resize(n);
+        xs.resize(n);
+        ys.resize(n);
+        vector<int> fill_pos(cell_start.begin(), cell_start.end() - 1);
+        for (int i = 0; i < n; i++) {
+            int slot = fill_pos[cell_of[i]]++;
+            ids[slot] = i;
+            xs[slot] = students[i].x;
+            ys[slot] = students[i].y;
+        }
+        inside.resize(n);
+    }
+    
+    // Appends every student within radius of p to out (unordered)
+    void students_within(Point p, double radius, vector<int>& out) {
+        double r2 = radius * radius;
+        int c0 = column(p.x - radius), c1 = column(p.x + radius);
+        int r0 = row(p.y - radius), r1 = row(p.y + radius);
         
-        // Save unselected stops
-        out << "UNSELECTED_STOPS" << endl;
-        set<int> selected_set(solution.begin(), solution.end());
-        for (int i = 0; i < num_candidates; i++) {
-            if (selected_set.find(i) == selected_set.end()) {
-                out << stop_positions[i].x << "," << stop_positions[i].y << endl;
+        for (int r = r0; r <= r1; r++) {
+            int begin = cell_start[r * cols + c0];
+            int end = cell_start[r * cols + c1 + 1];
+            const double* x = xs.data();
+            const double* y = ys.data();
+            unsigned char* mask = inside.data();
+            for (int k = begin; k < end; k++) {
+                double dx = x[k] - p.x, dy = y[k] - p.y;
+                mask[k] = dx * dx + dy * dy <= r2;
+            }
+            for (int k = begin; k < end; k++) {
+                if (mask[k]) out.push_back(ids[k]);
             }
         }
-        
-        out.close();
     }
 };
 
-// Generate coordinate-based instance
+// Coverage of the first num_stops stops by Euclidean distance, looking
+// only at the grid cells around each stop: O(n + stops + output)
+void set_coverage_within(BusStopPlacement& problem, double walking_distance, int num_stops) {
+    StudentGrid grid(problem.student_positions, walking_distance);
+    vector<int> covered_students;
+    for (int j = 0; j < num_stops; j++) {
+        covered_students.clear();
+        grid.students_within(problem.stop_positions[j], walking_distance, covered_students);
+        problem.set_coverage(j, covered_students);
+    }
+}
+
+// Generate coordinate-based instance (positions only when compute_coverage
+// is false; set_coverage_within() then builds the coverage separately)
 BusStopPlacement* generate_coordinate_based_instance(
     int num_students, int num_candidates, double walking_distance,
-    double grid_size, bool use_grid_stops, mt19937& rng) {
+    double grid_size, bool use_grid_stops, mt19937& rng,
+    bool compute_coverage = true) {
     
     BusStopPlacement* problem = new BusStopPlacement(num_students, num_candidates);
     
@@ -196,72 +1772,453 @@ BusStopPlacement* generate_coordinate_based_instance(
         }
     }
     
-    // Compute coverage based on Euclidean distance
-    for (int j = 0; j < num_candidates; j++) {
-        set<int> covered_students;
-        Point stop_pos = problem->stop_positions[j];
-        
-        for (int i = 0; i < num_students; i++) {
-            Point student_pos = problem->student_positions[i];
-            if (stop_pos.distance(student_pos) <= walking_distance) {
-                covered_students.insert(i);
-            }
+    if (compute_coverage) set_coverage_within(*problem, walking_distance, num_candidates);
+    return problem;
+}
+
+// Text instance in the sectioned layout of save_visualization_data():
+//   STUDENTS        then one "x,y" line per student
+//   STOPS           then one "x,y[,cost]" line per candidate stop
+//   COVERAGE        (optional) then one "stop,student" line per pair
+// Without a COVERAGE section the coverage is computed from the positions
+// and walking_distance (which must then be positive). The instance
+// replaces problem's contents through reset(), so a reused object keeps
+// its memory. False (message on cerr) on errors.
+bool read_csv_instance(const string& path, double walking_distance, BusStopPlacement& problem) {
+    ifstream in(path);
+    if (!in) {
+        cerr << "Error: cannot open " << path << endl;
+        return false;
+    }
+    vector<Point> students, stops;
+    vector<double> costs;
+    vector<pair<int, int>> pairs;
+    bool has_coverage = false;
+    int section = -1;
+    string line;
+    int line_number = 0;
+    while (getline(in, line)) {
+        line_number++;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty()) continue;
+        if (line == "STUDENTS" || line == "STOPS" || line == "COVERAGE") {
+            section = line == "STUDENTS" ? 0 : line == "STOPS" ? 1 : 2;
+            has_coverage = has_coverage || section == 2;
+            continue;
         }
         
-        problem->set_coverage(j, covered_students);
+        const char* p = line.c_str();
+        char* end;
+        double fields[3];
+        int count = 0;
+        while (count < 3) {
+            fields[count] = strtod(p, &end);
+            if (end == p) break;
+            count++;
+            p = end;
+            if (*p != ',') break;
+            p++;
+        }
+        bool ok = section >= 0 && count >= 2 && *p == '\0';
+        if (ok && section == 0) {
+            students.push_back({fields[0], fields[1]});
+        } else if (ok && section == 1) {
+            stops.push_back({fields[0], fields[1]});
+            costs.push_back(count == 3 ? fields[2] : 1.0);
+        } else if (ok && section == 2 && fields[0] >= 0 && fields[1] >= 0 &&
+                   fields[0] < INT_MAX && fields[1] < INT_MAX) {
+            pairs.push_back({(int)fields[0], (int)fields[1]});
+        } else {
+            cerr << "Error: " << path << ":" << line_number << ": unexpected line" << endl;
+            return false;
+        }
+    }
+    
+    int n = students.size(), m = stops.size();
+    for (auto& pr : pairs) {
+        if (pr.first >= m || pr.second >= n) {
+            cerr << "Error: " << path << ": coverage pair (" << pr.first << ", " << pr.second
+                 << ") out of range" << endl;
+            return false;
+        }
+    }
+    if (!has_coverage && walking_distance <= 0) {
+        cerr << "Error: " << path << " has no COVERAGE section; give a walking distance" << endl;
+        return false;
     }
     
+    problem.reset(n, m);
+    problem.student_positions = students;
+    problem.stop_positions = stops;
+    for (int j = 0; j < m; j++) problem.set_stop_cost(j, costs[j]);
+    if (has_coverage) {
+        // Group the pairs by stop with a counting sort
+        vector<int> start(m + 1, 0), members(pairs.size());
+        for (auto& pr : pairs) start[pr.first + 1]++;
+        for (int j = 0; j < m; j++) start[j + 1] += start[j];
+        vector<int> fill_pos(start.begin(), start.end() - 1);
+        for (auto& pr : pairs) members[fill_pos[pr.first]++] = pr.second;
+        vector<int> covered;
+        for (int j = 0; j < m; j++) {
+            covered.assign(members.begin() + start[j], members.begin() + start[j + 1]);
+            problem.set_coverage(j, covered);
+        }
+    } else {
+        set_coverage_within(problem, walking_distance, m);
+    }
+    return true;
+}
+
+BusStopPlacement* read_csv_instance(const string& path, double walking_distance) {
+    BusStopPlacement* problem = new BusStopPlacement(0, 0);
+    if (!read_csv_instance(path, walking_distance, *problem)) {
+        delete problem;
+        return nullptr;
+    }
     return problem;
 }
 
+void write_csv_instance(const BusStopPlacement& problem, const string& path) {
+    ofstream out(path);
+    out << setprecision(17);
+    out << "STUDENTS\n";
+    for (const Point& p : problem.student_positions) out << p.x << "," << p.y << "\n";
+    out << "STOPS\n";
+    for (int j = 0; j < problem.num_candidates; j++) {
+        out << problem.stop_positions[j].x << "," << problem.stop_positions[j].y << ","
+            << problem.stop_cost(j) << "\n";
+    }
+    out << "COVERAGE\n";
+    for (int j = 0; j < problem.num_candidates; j++) {
+        problem.for_each_covered(j, [&](int student) { out << j << "," << student << "\n"; });
+    }
+}
+
+// CSV -> binary instance file. Returns false if either side fails.
+bool convert_csv_instance(const string& csv_path, const string& binary_path,
+                          double walking_distance) {
+    BusStopPlacement* problem = read_csv_instance(csv_path, walking_distance);
+    if (!problem) return false;
+    bool ok = problem->save_instance(binary_path);
+    if (ok) {
+        cout << "Wrote " << problem->num_students << " students, " << problem->num_candidates
+             << " stops to " << binary_path << '\n';
+    } else {
+        cerr << "Error: cannot write " << binary_path << endl;
+    }
+    delete problem;
+    return ok;
+}
+
 // Benchmark runtime
+// num_candidates = 0 uses max(size, 100) candidate stops. The naive greedy
+// is timed next to the lazy one for sizes up to naive_limit (its column is
+// left empty above that, where it would run for hours). parallel_ms is the
+// parallel greedy on `threads` workers (all cores by default).
 void benchmark_runtime(vector<int>& sizes, double walking_distance, int trials, 
-                      const string& output_file) {
-    ofstream out(output_file);
-    out << "size,runtime_ms,num_stops" << endl;
+                      const string& output_file, int num_candidates = 0,
+                      int naive_limit = 2000, int threads = 0) {
+    ResultWriter out(output_file, {"size", "runtime_ms", "num_stops", "num_candidates",
+                                   "naive_ms", "speedup", "build_ms", "threads", "parallel_ms",
+                                   "greedy_iterations", "gain_evaluations", "elements_scanned",
+                                   "select_ms", "cover_ms"},
+                     result_formats);
+    
+    if (threads <= 0) threads = max(1u, thread::hardware_concurrency());
     
-    random_device rd;
-    mt19937 rng(rd());
+    mt19937 rng(benchmark_seed);
     
     for (int size : sizes) {
         cout << "Benchmarking size " << size << "..." << endl;
         
         for (int trial = 0; trial < trials; trial++) {
-            int num_candidates = max(size, 100);  // At least as many candidates as students
+            int candidates = num_candidates > 0 ? num_candidates
+                                                : max(size, 100);  // At least as many candidates as students
             
+            auto build_start = high_resolution_clock::now();
             auto problem = generate_coordinate_based_instance(
-                size, num_candidates, walking_distance, 1000.0, true, rng);
+                size, candidates, walking_distance, 1000.0, true, rng);
+            auto build_end = high_resolution_clock::now();
+            double build_ms = duration_cast<microseconds>(build_end - build_start).count() / 1000.0;
             
             auto start = high_resolution_clock::now();
             auto solution = problem->greedy_set_cover();
             auto end = high_resolution_clock::now();
+            GreedyStats greedy_stats = problem->last_greedy_stats();
             
             auto duration = duration_cast<microseconds>(end - start);
             double runtime_ms = duration.count() / 1000.0;
             
             if (!solution.empty()) {
-                out << size << "," << runtime_ms << "," << solution.size() << endl;
+                out << size << runtime_ms << solution.size()
+                    << candidates;
+                if (size <= naive_limit) {
+                    auto naive_start = high_resolution_clock::now();
+                    auto naive_solution = problem->greedy_set_cover_naive();
+                    auto naive_end = high_resolution_clock::now();
+                    double naive_ms = duration_cast<microseconds>(naive_end - naive_start).count() / 1000.0;
+                    
+                    if (naive_solution != solution) {
+                        cerr << "Error: lazy and naive greedy chose different stops" << endl;
+                    }
+                    out << naive_ms << (runtime_ms > 0 ? naive_ms / runtime_ms : 0.0);
+                } else {
+                    out.skip(2);
+                }
+                out << build_ms;
+                
+                problem->set_threads(threads);
+                auto parallel_start = high_resolution_clock::now();
+                auto parallel_solution = problem->greedy_set_cover_parallel();
+                auto parallel_end = high_resolution_clock::now();
+                problem->set_threads(1);
+                
+                if (parallel_solution != solution) {
+                    cerr << "Error: parallel and serial greedy chose different stops" << endl;
+                }
+                out << threads
+                    << duration_cast<microseconds>(parallel_end - parallel_start).count() / 1000.0;
+                if (instrumented) {
+                    out << greedy_stats.iterations << greedy_stats.gain_evaluations
+                        << greedy_stats.elements_scanned << greedy_stats.select_ms
+                        << greedy_stats.cover_ms;
+                } else {
+                    out.skip(5);
+                }
+                out.end_row();
+            }
+            
+            delete problem;
+        }
+    }
+    
+    out.close();
+    cout << "Results saved to " << output_file << '\n';
+}
+
+// Coverage representations on the same instances: bytes per stop and lazy
+// greedy time with posting lists only, bitsets only, and the automatic
+// per-stop choice
+void benchmark_coverage_modes(vector<int>& sizes, vector<double>& walking_distances,
+                              int trials, const string& output_file) {
+    ResultWriter out(output_file, {"size", "walking_distance", "mode", "bitset_stops",
+                                   "bytes_per_stop", "greedy_ms", "num_stops"}, result_formats);
+    
+    mt19937 rng(benchmark_seed);
+    
+    CoverageMode modes[] = {CoverageMode::LIST, CoverageMode::BITSET, CoverageMode::AUTO};
+    const char* mode_names[] = {"list", "bitset", "auto"};
+    
+    for (int size : sizes) {
+        for (double distance : walking_distances) {
+            cout << "Benchmarking coverage modes at size " << size
+                 << ", walking distance " << distance << "..." << endl;
+            
+            for (int trial = 0; trial < trials; trial++) {
+                auto problem = generate_coordinate_based_instance(
+                    size, size, distance, 1000.0, true, rng);
+                
+                for (int k = 0; k < 3; k++) {
+                    problem->set_coverage_mode(modes[k]);
+                    
+                    auto start = high_resolution_clock::now();
+                    auto solution = problem->greedy_set_cover();
+                    auto end = high_resolution_clock::now();
+                    
+                    out << size << distance << mode_names[k]
+                        << problem->bitset_stop_count()
+                        << (double)problem->coverage_bytes() / problem->num_candidates
+                        << duration_cast<microseconds>(end - start).count() / 1000.0
+                        << solution.size();
+                    out.end_row();
+                }
+                
+                delete problem;
+            }
+        }
+    }
+    
+    out.close();
+    cout << "Results saved to " << output_file << '\n';
+}
+
+// Budget what-if sweep on one instance with random stop costs in [1, 10]:
+// the cheapest full cover first, then the budgeted max coverage per budget
+void benchmark_budgets(int size, int num_candidates, double walking_distance,
+                       vector<double>& budgets, const string& output_file) {
+    ResultWriter out(output_file, {"budget", "num_stops", "covered", "cost", "runtime_ms"},
+                     result_formats);
+    
+    mt19937 rng(benchmark_seed);
+    uniform_real_distribution<double> cost(1.0, 10.0);
+    
+    auto problem = generate_coordinate_based_instance(
+        size, num_candidates, walking_distance, 1000.0, true, rng);
+    for (int j = 0; j < num_candidates; j++) {
+        problem->set_stop_cost(j, cost(rng));
+    }
+    
+    auto start = high_resolution_clock::now();
+    auto cover = problem->weighted_set_cover();
+    auto end = high_resolution_clock::now();
+    double cover_cost = 0;
+    for (int stop : cover) cover_cost += problem->stop_cost(stop);
+    cout << "Weighted cover: " << cover.size() << " stops, cost " << cover_cost << '\n';
+    
+    double sweep_ms = 0;
+    for (double budget : budgets) {
+        start = high_resolution_clock::now();
+        auto result = problem->budgeted_max_coverage(budget);
+        end = high_resolution_clock::now();
+        double runtime_ms = duration_cast<microseconds>(end - start).count() / 1000.0;
+        sweep_ms += runtime_ms;
+        
+        out << budget << result.stops.size() << result.covered
+            << result.cost << runtime_ms;
+        out.end_row();
+    }
+    cout << "Swept " << budgets.size() << " budgets in " << sweep_ms << " ms" << '\n';
+    
+    delete problem;
+    out.close();
+    cout << "Results saved to " << output_file << '\n';
+}
+
+// Kernelization on grid-stop instances: reduction counts and kernel size,
+// then the greedy per component (on all cores) against the plain greedy
+void benchmark_kernel(vector<int>& sizes, double walking_distance, int trials,
+                      const string& output_file) {
+    ResultWriter out(output_file, {"size", "num_candidates", "forced", "dominated_stops",
+                                   "dominated_students", "kernel_students", "kernel_stops",
+                                   "components", "kernel_ms", "solve_ms", "num_stops",
+                                   "greedy_ms", "greedy_stops"}, result_formats);
+    
+    mt19937 rng(benchmark_seed);
+    int threads = max(1u, thread::hardware_concurrency());
+    
+    for (int size : sizes) {
+        cout << "Benchmarking kernelization at size " << size << "..." << endl;
+        
+        for (int trial = 0; trial < trials; trial++) {
+            int num_candidates = size;
+            auto problem = generate_coordinate_based_instance(
+                size, num_candidates, walking_distance, 1000.0, true, rng);
+            
+            auto start = high_resolution_clock::now();
+            SetCoverKernel kernel(*problem);
+            auto mid = high_resolution_clock::now();
+            auto solution = kernel.solve([](BusStopPlacement& component) {
+                return component.greedy_set_cover();
+            }, threads);
+            auto end = high_resolution_clock::now();
+            
+            auto greedy_start = high_resolution_clock::now();
+            auto greedy = problem->greedy_set_cover();
+            auto greedy_end = high_resolution_clock::now();
+            
+            if (!solution.empty() && !problem->verify_solution(solution)) {
+                cerr << "Error: kernel solution does not cover every student" << endl;
             }
             
+            out << size << num_candidates << kernel.forced_stops()
+                << kernel.dominated_stops() << kernel.dominated_students()
+                << kernel.kernel_students() << kernel.kernel_stops()
+                << kernel.components()
+                << duration_cast<microseconds>(mid - start).count() / 1000.0
+                << duration_cast<microseconds>(end - mid).count() / 1000.0
+                << solution.size()
+                << duration_cast<microseconds>(greedy_end - greedy_start).count() / 1000.0
+                << greedy.size();
+            out.end_row();
+            
             delete problem;
         }
     }
     
     out.close();
-    cout << "Results saved to " << output_file << endl;
+    cout << "Results saved to " << output_file << '\n';
+}
+
+// Loading an instance from CSV (parse + posting lists) against the mapped
+// binary file, then the greedy on each. The files are written to data/ and
+// removed afterwards; they are usually still in the page cache, so
+// binary_load_ms is a warm-cache figure.
+void benchmark_load(vector<int>& sizes, double walking_distance, const string& output_file) {
+    ResultWriter out(output_file, {"size", "num_candidates", "coverage_entries", "csv_mb",
+                                   "binary_mb", "csv_load_ms", "binary_load_ms", "speedup",
+                                   "csv_greedy_ms", "binary_greedy_ms", "num_stops"},
+                     result_formats);
+    
+    mt19937 rng(benchmark_seed);
+    
+    for (int size : sizes) {
+        cout << "Benchmarking instance loading at size " << size << "..." << endl;
+        
+        BusStopPlacement* generated = generate_coordinate_based_instance(
+            size, size, walking_distance, 1000.0, true, rng);
+        int num_candidates = generated->num_candidates;
+        string csv_path = "data/busstop_" + to_string(size) + ".csv";
+        string binary_path = "data/busstop_" + to_string(size) + ".bin";
+        write_csv_instance(*generated, csv_path);
+        generated->save_instance(binary_path);
+        long long entries = 0;
+        for (int j = 0; j < num_candidates; j++) entries += generated->coverage_size(j);
+        delete generated;
+        
+        auto start = high_resolution_clock::now();
+        BusStopPlacement* from_csv = read_csv_instance(csv_path, 0.0);
+        auto csv_loaded = high_resolution_clock::now();
+        auto csv_solution = from_csv->greedy_set_cover();
+        auto csv_solved = high_resolution_clock::now();
+        BusStopPlacement* from_binary = BusStopPlacement::load_instance(binary_path);
+        auto binary_loaded = high_resolution_clock::now();
+        auto binary_solution = from_binary->greedy_set_cover();
+        auto binary_solved = high_resolution_clock::now();
+        
+        if (csv_solution != binary_solution) {
+            cerr << "Error: CSV and binary instances give different greedy covers" << endl;
+        }
+        
+        ifstream csv_file(csv_path, ios::binary | ios::ate), binary_file(binary_path, ios::binary | ios::ate);
+        double csv_mb = csv_file.tellg() / 1e6, binary_mb = binary_file.tellg() / 1e6;
+        double csv_ms = duration_cast<microseconds>(csv_loaded - start).count() / 1000.0;
+        double binary_ms = duration_cast<microseconds>(binary_loaded - csv_solved).count() / 1000.0;
+        out << size << num_candidates << entries << csv_mb
+            << binary_mb << csv_ms << binary_ms
+            << (binary_ms > 0 ? csv_ms / binary_ms : 0.0)
+            << duration_cast<microseconds>(csv_solved - csv_loaded).count() / 1000.0
+            << duration_cast<microseconds>(binary_solved - binary_loaded).count() / 1000.0
+            << binary_solution.size();
+        out.end_row();
+        
+        delete from_csv;
+        delete from_binary;
+        remove(csv_path.c_str());
+        remove(binary_path.c_str());
+    }
+    
+    out.close();
+    cout << "Results saved to " << output_file << '\n';
 }
 
 // Compare walking distances
+// Each greedy cover is then improved by CoverLocalSearch for at most
+// improve_limit_ms: stops_saved against improve_ms. Up to exact_limit
+// students ExactSetCover also runs (exact_limit_ms each) and greedy_gap is
+// (greedy - lower bound) / greedy, the same normalisation as
+// ExactResult::gap(); the exact columns stay empty above.
 void compare_walking_distances(int size, vector<double>& walking_distances, 
-                               int trials, const string& output_file) {
-    ofstream out(output_file);
-    out << "walking_distance,num_stops" << endl;
+                               int trials, const string& output_file,
+                               double improve_limit_ms = 100.0,
+                               int exact_limit = 200, double exact_limit_ms = 2000.0) {
+    ResultWriter out(output_file, {"walking_distance", "num_stops", "improved_stops",
+                                   "stops_saved", "improve_ms", "exact_stops", "lower_bound",
+                                   "greedy_gap", "proven_optimal"}, result_formats);
     
-    random_device rd;
-    mt19937 rng(rd());
+    mt19937 rng(benchmark_seed);
     
     for (double distance : walking_distances) {
-        cout << "Testing walking distance " << distance << "..." << endl;
+        cout << "Testing walking distance " << distance << "..." << '\n';
         
         for (int trial = 0; trial < trials; trial++) {
             int num_candidates = max((int)(3 * sqrt(size)), 30);
@@ -272,7 +2229,26 @@ void compare_walking_distances(int size, vector<double>& walking_distances,
             auto solution = problem->greedy_set_cover();
             
             if (!solution.empty()) {
-                out << distance << "," << solution.size() << endl;
+                auto start = high_resolution_clock::now();
+                CoverLocalSearch search(*problem, solution);
+                search.run(improve_limit_ms);
+                auto improved = search.solution();
+                auto end = high_resolution_clock::now();
+                
+                out << distance << solution.size() << improved.size()
+                    << solution.size() - improved.size()
+                    << duration_cast<microseconds>(end - start).count() / 1000.0;
+                if (size <= exact_limit) {
+                    ExactSetCover exact(*problem);
+                    auto result = exact.solve(exact_limit_ms);
+                    double greedy_cost = solution.size();
+                    out << result.stops.size() << result.lower_bound
+                        << (greedy_cost > 0 ? (greedy_cost - result.lower_bound) / greedy_cost : 0.0)
+                        << (result.optimal ? 1 : 0);
+                } else {
+                    out.skip(4);
+                }
+                out.end_row();
             }
             
             delete problem;
@@ -280,14 +2256,238 @@ void compare_walking_distances(int size, vector<double>& walking_distances,
     }
     
     out.close();
-    cout << "Results saved to " << output_file << endl;
+    cout << "Results saved to " << output_file << '\n';
+}
+
+// Ticks of re-planning with fresh student positions on a fixed square
+// grid of stops: a new BusStopPlacement per tick ("fresh") against one
+// object reset() every tick ("reuse"), on the same instances. Per tick:
+// heap allocations and bytes requested (alloc_stats.h, only when built
+// with -DALLOC_STATS), time to fill positions and coverage, greedy time,
+// and the peak RSS during the tick (the process peak where it cannot be
+// reset).
+void benchmark_allocation(vector<int>& sizes, vector<int>& grid_dims, double walking_distance,
+                          int ticks, const string& output_file) {
+    ResultWriter out(output_file, {"mode", "size", "num_candidates", "tick", "allocations",
+                                   "alloc_mb", "fill_ms", "greedy_ms", "num_stops", "peak_rss_mb"},
+                     result_formats);
+    
+    for (size_t k = 0; k < sizes.size(); k++) {
+        int size = sizes[k], dim = grid_dims[k], candidates = dim * dim;
+        cout << "Benchmarking allocation at size " << size << "..." << endl;
+        
+        vector<Point> stops;
+        for (int i = 0; i < dim; i++) {
+            for (int j = 0; j < dim; j++) {
+                stops.push_back({i * 1000.0 / (dim - 1), j * 1000.0 / (dim - 1)});
+            }
+        }
+        
+        for (int reuse = 0; reuse < 2; reuse++) {
+            mt19937 rng(benchmark_seed);
+            uniform_real_distribution<double> coord(0.0, 1000.0);
+            vector<Point> students(size);
+            BusStopPlacement* kept = reuse ? new BusStopPlacement(size, candidates) : nullptr;
+            
+            for (int tick = 0; tick < ticks; tick++) {
+                for (Point& p : students) p = {coord(rng), coord(rng)};
+                reset_peak_rss();
+                AllocStats before = alloc_snapshot();
+                
+                auto start = high_resolution_clock::now();
+                BusStopPlacement* problem = kept;
+                if (kept) {
+                    kept->reset(size, candidates);
+                } else {
+                    problem = new BusStopPlacement(size, candidates);
+                }
+                for (int i = 0; i < size; i++) problem->set_student_position(i, students[i]);
+                for (int j = 0; j < candidates; j++) problem->set_stop_position(j, stops[j]);
+                set_coverage_within(*problem, walking_distance, candidates);
+                auto mid = high_resolution_clock::now();
+                auto solution = problem->greedy_set_cover();
+                auto end = high_resolution_clock::now();
+                if (!kept) delete problem;
+                
+                AllocStats used = alloc_since(before);
+                out << (reuse ? "reuse" : "fresh") << size << candidates << tick;
+                if (alloc_counting) {
+                    out << used.allocations << used.bytes / 1048576.0;
+                } else {
+                    out.skip(2);
+                }
+                out << duration_cast<microseconds>(mid - start).count() / 1000.0
+                    << duration_cast<microseconds>(end - mid).count() / 1000.0
+                    << solution.size() << peak_rss_bytes() / 1048576.0;
+                out.end_row();
+            }
+            delete kept;
+        }
+    }
+    
+    out.close();
+    cout << "Results saved to " << output_file << '\n';
+}
+
+// One batch job: read the instance file into this worker's reusable object
+// (binary format when the name ends in ".bin", sectioned CSV otherwise;
+// walking_distance is used for CSVs without a COVERAGE section) and run
+// the lazy greedy. Result line:
+// file,students,candidates,num_stops,load_ms,greedy_ms or file,error
+string solve_batch_instance(BusStopPlacement& problem, const string& path, double walking_distance) {
+    auto start = high_resolution_clock::now();
+    bool binary = path.size() >= 4 && path.compare(path.size() - 4, 4, ".bin") == 0;
+    bool loaded = binary ? BusStopPlacement::load_instance(path, problem)
+                         : read_csv_instance(path, walking_distance, problem);
+    if (!loaded) return path + ",error";
+    auto mid = high_resolution_clock::now();
+    auto solution = problem.greedy_set_cover();
+    auto end = high_resolution_clock::now();
+    
+    ostringstream line;
+    line << path << ',' << problem.num_students << ',' << problem.num_candidates << ','
+         << solution.size() << ','
+         << duration_cast<microseconds>(mid - start).count() / 1000.0 << ','
+         << duration_cast<microseconds>(end - mid).count() / 1000.0;
+    return line.str();
+}
+
+// Batch mode: solve the instance files (or, when none are given, one path
+// per line of stdin, read while earlier instances are being solved) on
+// `threads` workers, each with its own reusable BusStopPlacement.
+// Results go to cout as CSV in input order; a summary goes to cerr.
+// Returns the number of instances that could not be loaded.
+int run_batch(int threads, const vector<string>& files, double walking_distance) {
+    vector<unique_ptr<BusStopPlacement>> worker_problems;
+    for (int w = 0; w < threads; w++) worker_problems.emplace_back(new BusStopPlacement(0, 0));
+    atomic<int> errors(0);
+    
+    cout << "file,students,candidates,num_stops,load_ms,greedy_ms" << '\n';
+    auto start = high_resolution_clock::now();
+    BatchPool pool(threads, [&](int w, const string& path) {
+        string result = solve_batch_instance(*worker_problems[w], path, walking_distance);
+        if (result.size() >= 6 && result.compare(result.size() - 6, 6, ",error") == 0) errors++;
+        return result;
+    }, cout);
+    if (files.empty()) {
+        string line;
+        while (getline(cin, line)) {
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            if (!line.empty()) pool.submit(line);
+        }
+    } else {
+        for (const string& file : files) pool.submit(file);
+    }
+    size_t count = pool.finish();
+    double ms = duration_cast<microseconds>(high_resolution_clock::now() - start).count() / 1000.0;
+    
+    cerr << "Solved " << count << " instances in " << ms << " ms ("
+         << (ms > 0 ? count * 1000.0 / ms : 0.0) << " per second) on " << threads
+         << " threads; " << pool.steals() << " stolen, " << errors << " failed" << endl;
+    return errors;
+}
+
+// Batch throughput: `instances` zones with student counts spread over
+// [size / 4, 7 * size / 4) and a square grid of `candidates` stops (so
+// every zone is coverable) are written as binary files, then solved by
+// run_batch's pool with 1, 2, 4, ... up to max_threads workers. Results
+// are discarded; the files are removed afterwards.
+void benchmark_batch(int instances, int size, int candidates, double walking_distance,
+                     int max_threads, const string& output_file) {
+    ResultWriter out(output_file, {"threads", "instances", "total_ms", "instances_per_sec",
+                                   "speedup", "steals"}, result_formats);
+    
+    mt19937 rng(benchmark_seed);
+    uniform_int_distribution<int> zone_size(size / 4, 7 * size / 4 - 1);
+    vector<string> files;
+    for (int k = 0; k < instances; k++) {
+        BusStopPlacement* problem = generate_coordinate_based_instance(
+            zone_size(rng), candidates, walking_distance, 1000.0, true, rng);
+        files.push_back("data/batch_zone_" + to_string(k) + ".bin");
+        problem->save_instance(files.back());
+        delete problem;
+    }
+    
+    vector<int> thread_counts;
+    for (int t = 1; t < max_threads; t *= 2) thread_counts.push_back(t);
+    thread_counts.push_back(max_threads);
+    
+    double base_rate = 0;
+    for (int threads : thread_counts) {
+        cout << "Benchmarking batch of " << instances << " zones on " << threads << " threads..." << endl;
+        vector<unique_ptr<BusStopPlacement>> worker_problems;
+        for (int w = 0; w < threads; w++) worker_problems.emplace_back(new BusStopPlacement(0, 0));
+        ostream discard(nullptr);
+        
+        auto start = high_resolution_clock::now();
+        BatchPool pool(threads, [&](int w, const string& path) {
+            return solve_batch_instance(*worker_problems[w], path, walking_distance);
+        }, discard);
+        for (const string& file : files) pool.submit(file);
+        pool.finish();
+        double ms = duration_cast<microseconds>(high_resolution_clock::now() - start).count() / 1000.0;
+        
+        double rate = ms > 0 ? instances * 1000.0 / ms : 0.0;
+        if (threads == 1) base_rate = rate;
+        out << threads << instances << ms << rate << (base_rate > 0 ? rate / base_rate : 0.0)
+            << pool.steals();
+        out.end_row();
+    }
+    
+    for (const string& file : files) remove(file.c_str());
+    out.close();
+    cout << "Results saved to " << output_file << '\n';
+}
+
+// Reproducible benchmark suite (see bench_harness.h): fixed-seed instances,
+// per-stage timings, a JSON baseline, and a comparison against an old one.
+// Candidate counts are full square grids of stops, so every instance is
+// coverable. Returns the number of regressions found (0 when not comparing).
+int run_bench_suite(const string& output_file, const string& baseline_file,
+                    double threshold, int repetitions) {
+    BenchSuite suite("problem2_busstop", benchmark_seed, 2, repetitions);
+
+    struct SuiteCase { int students, candidates; double walking_distance; };
+    for (SuiteCase c : {SuiteCase{1000, 1024, 200.0}, SuiteCase{10000, 1024, 50.0},
+                        SuiteCase{100000, 10000, 20.0}}) {
+        string name = "grid_n" + to_string(c.students) + "_m" + to_string(c.candidates) +
+                      "_wd" + to_string((int)c.walking_distance);
+        suite.add(name, [c](BenchRun& run) {
+            BusStopPlacement* problem = nullptr;
+            vector<int> solution;
+            bool covered = false;
+            run.time("generate", [&] {
+                problem = generate_coordinate_based_instance(c.students, c.candidates, c.walking_distance,
+                                                             1000.0, true, run.rng, false);
+            });
+            run.time("build", [&] { set_coverage_within(*problem, c.walking_distance, c.candidates); });
+            run.time("solve", [&] { solution = problem->greedy_set_cover(); });
+            run.time("extract", [&] { covered = problem->verify_solution(solution); });
+            run.check("num_stops", solution.size());
+            run.check("covered", covered);
+            delete problem;
+        });
+    }
+
+    suite.run();
+    if (suite.write_json(output_file)) {
+        cout << "\nResults saved to " << output_file << '\n';
+    } else {
+        cerr << "Error: cannot write " << output_file << endl;
+    }
+    if (baseline_file.empty()) return 0;
+
+    int regressions = suite.compare(baseline_file, threshold);
+    if (regressions < 0) return 1;
+    cout << "\n" << regressions << " regression(s) above " << threshold * 100 << "%" << '\n';
+    return regressions;
 }
 
 // Demonstration example
 void demo_example() {
-    cout << "\n============================================================" << endl;
-    cout << "Demonstration: Small Example" << endl;
-    cout << "============================================================\n" << endl;
+    cout << "\n============================================================" << '\n';
+    cout << "Demonstration: Small Example" << '\n';
+    cout << "============================================================\n" << '\n';
     
     // Create small instance manually
     BusStopPlacement problem(6, 4);
@@ -298,56 +2498,96 @@ void demo_example() {
     problem.set_coverage(2, {2, 4, 5});
     problem.set_coverage(3, {3, 5});
     
-    cout << "Problem Setup:" << endl;
-    cout << "  Students: 6" << endl;
-    cout << "  Candidate stops: 4" << endl;
-    cout << "  Coverage:" << endl;
-    cout << "    Stop 0 → Students {0, 1, 2}" << endl;
-    cout << "    Stop 1 → Students {1, 3, 4}" << endl;
-    cout << "    Stop 2 → Students {2, 4, 5}" << endl;
-    cout << "    Stop 3 → Students {3, 5}" << endl;
+    cout << "Problem Setup:" << '\n';
+    cout << "  Students: 6" << '\n';
+    cout << "  Candidate stops: 4" << '\n';
+    cout << "  Coverage:" << '\n';
+    cout << "    Stop 0 → Students {0, 1, 2}" << '\n';
+    cout << "    Stop 1 → Students {1, 3, 4}" << '\n';
+    cout << "    Stop 2 → Students {2, 4, 5}" << '\n';
+    cout << "    Stop 3 → Students {3, 5}" << '\n';
     
     // Solve
     auto solution = problem.greedy_set_cover();
     
-    cout << "\nGreedy Solution:" << endl;
-    cout << "  Number of stops: " << solution.size() << endl;
+    cout << "\nGreedy Solution:" << '\n';
+    cout << "  Number of stops: " << solution.size() << '\n';
     cout << "  Selected stops: ";
     for (int i = 0; i < solution.size(); i++) {
         if (i > 0) cout << ", ";
         cout << solution[i];
     }
-    cout << endl;
+    cout << '\n';
+    
+    CoverLocalSearch search(problem, solution);
+    search.run(10.0);
+    cout << "  After local search: " << search.solution().size() << " stops" << '\n';
+    
+    ExactSetCover exact(problem);
+    auto optimum = exact.solve(1000.0);
+    cout << "  Exact optimum (branch and bound): " << optimum.stops.size() << " stops"
+         << (optimum.optimal ? " (proven)" : "") << '\n';
     
-    cout << "\nNote: For this instance, the optimal solution uses 2 stops." << endl;
-    cout << "      For example: Stops {0, 1} or Stops {0, 3}" << endl;
-    cout << "      Greedy may not always find optimal (expected for NP-hard problem)\n" << endl;
+    cout << "\nNote: Every pair of stops leaves a student uncovered here, so greedy's" << '\n';
+    cout << "      3 stops are optimal. Greedy may not always find optimal" << '\n';
+    cout << "      (expected for NP-hard problem)\n" << '\n';
     
     problem.print_stats(solution);
 }
 
 int main(int argc, char* argv[]) {
-    cout << "============================================================" << endl;
-    cout << "Problem 2: School Bus Stop Placement Experiments" << endl;
-    cout << "============================================================\n" << endl;
+    for (int k = 1; k < argc; k++) {
+        if (string(argv[k]) == "--columns") result_formats |= RESULT_COLUMNS;
+        if (string(argv[k]) == "--seed" && k + 1 < argc) benchmark_seed = strtoul(argv[k + 1], nullptr, 10);
+    }
+    
+    // Batch mode writes only results to stdout: no banner or demo
+    if (argc > 1 && string(argv[1]) == "--batch") {
+        int threads = max(1u, thread::hardware_concurrency());
+        double walking_distance = 0.0;
+        vector<string> files;
+        for (int k = 2; k < argc; k++) {
+            if (string(argv[k]) == "--threads" && k + 1 < argc) {
+                threads = max(1, atoi(argv[++k]));
+            } else if (string(argv[k]) == "--columns") {
+                // global flags, already read above
+            } else if (string(argv[k]) == "--seed" && k + 1 < argc) {
+                k++;
+            } else if (string(argv[k]) == "--walking-distance" && k + 1 < argc) {
+                walking_distance = atof(argv[++k]);
+            } else {
+                files.push_back(argv[k]);
+            }
+        }
+        return run_batch(threads, files, walking_distance) == 0 ? 0 : 1;
+    }
+    
+    cout << "============================================================" << '\n';
+    cout << "Problem 2: School Bus Stop Placement Experiments" << '\n';
+    cout << "============================================================\n" << '\n';
     
     // Run demonstration
     demo_example();
     
     // Run benchmarks if requested
     if (argc > 1 && string(argv[1]) == "--benchmark") {
-        cout << "\n============================================================" << endl;
-        cout << "Running Benchmarks" << endl;
-        cout << "============================================================\n" << endl;
+        cout << "\n============================================================" << '\n';
+        cout << "Running Benchmarks" << '\n';
+        cout << "============================================================\n" << '\n';
         
         // Runtime analysis
-        cout << "\nRuntime analysis..." << endl;
+        cout << "\nRuntime analysis..." << '\n';
         vector<int> sizes = {100, 200, 300, 400, 500, 750, 1000};
         double walking_distance = 200.0;
         benchmark_runtime(sizes, walking_distance, 5, "data/setcover_runtime.csv");
         
+        // Lazy greedy at scale: 100k and 1M students, 50k candidate stops
+        cout << "\nLarge-scale runtime analysis..." << '\n';
+        vector<int> large_sizes = {100000, 1000000};
+        benchmark_runtime(large_sizes, 20.0, 3, "data/setcover_runtime_large.csv", 50000);
+        
         // Walking distance comparison
-        cout << "\nWalking distance comparison..." << endl;
+        cout << "\nWalking distance comparison..." << '\n';
         vector<double> distances = {150, 200, 250, 300};
         vector<int> test_sizes = {100, 150, 200};
         
@@ -357,20 +2597,97 @@ int main(int argc, char* argv[]) {
         }
         
         // Generate visualization data
-        cout << "\nGenerating visualization data..." << endl;
-        random_device rd;
-        mt19937 rng(rd());
+        cout << "\nGenerating visualization data..." << '\n';
+        mt19937 rng(benchmark_seed);
         auto vis_problem = generate_coordinate_based_instance(80, 80, 250.0, 1000.0, true, rng);
         auto vis_solution = vis_problem->greedy_set_cover();
         vis_problem->save_visualization_data(vis_solution, "data/visualization.csv");
         delete vis_problem;
         
-        cout << "\n============================================================" << endl;
-        cout << "Benchmarks completed!" << endl;
-        cout << "Run Python script to generate plots from CSV data." << endl;
-        cout << "============================================================" << endl;
+        cout << "\n============================================================" << '\n';
+        cout << "Benchmarks completed!" << '\n';
+        cout << "Run Python script to generate plots from CSV data." << '\n';
+        cout << "============================================================" << '\n';
+    } else if (argc > 1 && string(argv[1]) == "--benchmark-coverage") {
+        cout << "\n============================================================" << '\n';
+        cout << "Coverage Representation Benchmark (lists vs bitsets)" << '\n';
+        cout << "============================================================\n" << '\n';
+        
+        vector<int> sizes = {1000, 5000, 20000};
+        vector<double> distances = {50, 100, 250};
+        benchmark_coverage_modes(sizes, distances, 3, "data/setcover_coverage.csv");
+    } else if (argc > 1 && string(argv[1]) == "--benchmark-budget") {
+        cout << "\n============================================================" << '\n';
+        cout << "Budgeted Max-Coverage Sweep" << '\n';
+        cout << "============================================================\n" << '\n';
+        
+        vector<double> budgets;
+        for (double b = 50; b <= 2000; b += 50) budgets.push_back(b);
+        benchmark_budgets(100000, 20000, 20.0, budgets, "data/setcover_budget.csv");
+    } else if (argc > 1 && string(argv[1]) == "--benchmark-kernel") {
+        cout << "\n============================================================" << '\n';
+        cout << "Kernelization Benchmark (grid stops)" << '\n';
+        cout << "============================================================\n" << '\n';
+        
+        vector<int> sizes = {10000, 50000, 100000};
+        benchmark_kernel(sizes, 20.0, 3, "data/setcover_kernel.csv");
+    } else if (argc > 1 && string(argv[1]) == "--benchmark-load") {
+        cout << "\n============================================================" << '\n';
+        cout << "Instance Loading Benchmark (CSV vs mapped binary)" << '\n';
+        cout << "============================================================\n" << '\n';
+        
+        vector<int> sizes = {10000, 50000, 100000};
+        benchmark_load(sizes, 20.0, "data/setcover_load.csv");
+    } else if (argc > 1 && string(argv[1]) == "--benchmark-alloc") {
+        cout << "\n============================================================" << '\n';
+        cout << "Allocation Benchmark (fresh objects vs reset and reuse)" << '\n';
+        cout << "============================================================\n" << '\n';
+        
+        vector<int> sizes = {10000, 100000};
+        vector<int> grid_dims = {100, 100};
+        benchmark_allocation(sizes, grid_dims, 20.0, 20, "data/setcover_alloc.csv");
+    } else if (argc > 1 && string(argv[1]) == "--benchmark-batch") {
+        cout << "\n============================================================" << '\n';
+        cout << "Batch Throughput Benchmark (work-stealing pool over zone files)" << '\n';
+        cout << "============================================================\n" << '\n';
+        
+        int max_threads = argc > 2 ? atoi(argv[2]) : (int)max(1u, thread::hardware_concurrency());
+        benchmark_batch(256, 20000, 1024, 50.0, max(1, max_threads), "data/setcover_batch.csv");
+    } else if (argc > 1 && string(argv[1]) == "--bench-suite") {
+        cout << "\n============================================================" << '\n';
+        cout << "Benchmark Suite (seed " << benchmark_seed << ")" << '\n';
+        cout << "============================================================\n" << '\n';
+        
+        string output = argc > 2 && argv[2][0] != '-' ? argv[2] : "data/bench_baseline_problem2.json";
+        int repetitions = argc > 3 && argv[3][0] != '-' ? atoi(argv[3]) : 30;
+        run_bench_suite(output, "", 0, repetitions);
+    } else if (argc > 2 && string(argv[1]) == "--bench-compare") {
+        cout << "\n============================================================" << '\n';
+        cout << "Benchmark Suite vs " << argv[2] << " (seed " << benchmark_seed << ")" << '\n';
+        cout << "============================================================\n" << '\n';
+        
+        double threshold = argc > 3 && argv[3][0] != '-' ? atof(argv[3]) : 0.10;
+        int repetitions = argc > 4 && argv[4][0] != '-' ? atoi(argv[4]) : 30;
+        return run_bench_suite("data/bench_current_problem2.json", argv[2], threshold, repetitions) == 0 ? 0 : 1;
+    } else if (argc > 3 && string(argv[1]) == "--convert-csv") {
+        double walking_distance = argc > 4 ? atof(argv[4]) : 0.0;
+        return convert_csv_instance(argv[2], argv[3], walking_distance) ? 0 : 1;
+    } else if (argc > 2 && string(argv[1]) == "--load") {
+        auto start = high_resolution_clock::now();
+        BusStopPlacement* problem = BusStopPlacement::load_instance(argv[2]);
+        if (!problem) return 1;
+        auto mid = high_resolution_clock::now();
+        auto solution = problem->greedy_set_cover();
+        auto end = high_resolution_clock::now();
+        
+        cout << "\nLoaded " << argv[2] << " in "
+             << duration_cast<microseconds>(mid - start).count() / 1000.0 << " ms" << '\n';
+        problem->print_stats(solution);
+        cout << "Greedy time: " << duration_cast<microseconds>(end - mid).count() / 1000.0
+             << " ms" << '\n';
+        delete problem;
     } else {
-        cout << "\nTo run benchmarks, use: " << argv[0] << " --benchmark" << endl;
+        cout << "\nTo run benchmarks, use: " << argv[0] << " --benchmark" << '\n';
     }
     
     return 0;
@@ -0,0 +1,292 @@
+/*
+ * Buffered, asynchronous result tables shared by both problems
+ * ============================================================
+ *
+ * A ResultWriter collects rows on the calling thread and hands
+ * them over in batches to a background thread, which formats and writes
+ * them with large fwrite() calls. Solver timings never include disk I/O,
+ * and nothing is flushed per row.
+ *
+ * Outputs (any combination):
+ * - RESULT_CSV: a CSV file with a header line (unless disabled); plain
+ *   text lines can be interleaved with text(), e.g. section markers,
+ * - RESULT_COLUMNS: a column dump next to it (path with ".cols" in place
+ *   of ".csv"): "RESCOLS1", uint32 version, uint32 columns, uint64 rows,
+ *   then per column a uint32 name length and the name, zero padding to a
+ *   multiple of 8 bytes, and finally every column as `rows` doubles,
+ *   column after column (numpy.fromfile can read each one directly).
+ *   Text and empty cells are stored as NaN there.
+ *
+ * close() (or the destructor) drains the queue and writes the column dump.
+ */
+
+#ifndef RESULT_WRITER_H
+#define RESULT_WRITER_H
+
+#include <condition_variable>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+enum ResultFormat {
+    RESULT_CSV = 1,
+    RESULT_COLUMNS = 2
+};
+
+class ResultWriter {
+private:
+    enum CellKind : uint8_t { REAL, INTEGER, TEXT, EMPTY };
+
+    struct Cell {
+        double value;     // TEXT: index into Batch::texts
+        CellKind kind;
+    };
+
+    // Rows in arrival order; lines[k] = (cell index, text) goes before that cell
+    struct Batch {
+        std::vector<Cell> cells;
+        std::vector<std::string> texts;
+        std::vector<std::pair<size_t, std::string>> lines;
+    };
+
+    static const size_t BATCH_CELLS = 1 << 14;
+    static const size_t BUFFER_BYTES = 1 << 20;
+
+    std::string path;
+    std::vector<std::string> columns;
+    int formats;
+    FILE* csv;
+    bool failed, closed;
+
+    Batch current;          // Filled by the caller
+    size_t row_cells;       // Cells in the caller's unfinished row
+    long long rows;
+
+    std::deque<Batch> queue;
+    std::mutex mtx;
+    std::condition_variable ready;
+    bool stopping;
+    std::thread worker;
+
+    // Owned by the worker (until it is joined)
+    std::string buffer;
+    bool write_failed;
+    std::vector<std::vector<double>> column_data;
+
+    void format_cell(const Batch& batch, const Cell& cell, bool first) {
+        if (!first) buffer += ',';
+        char text[32];
+        int length = 0;
+        switch (cell.kind) {
+            case REAL: length = std::snprintf(text, sizeof(text), "%g", cell.value); break;
+            case INTEGER: length = std::snprintf(text, sizeof(text), "%lld", (long long)cell.value); break;
+            case TEXT: buffer += batch.texts[(size_t)cell.value]; break;
+            case EMPTY: break;
+        }
+        buffer.append(text, length);
+    }
+
+    void write_batch(const Batch& batch) {
+        size_t width = columns.size();
+        size_t line = 0;
+        for (size_t k = 0; k < batch.cells.size(); k++) {
+            for (; line < batch.lines.size() && batch.lines[line].first == k; line++) {
+                buffer += batch.lines[line].second;
+                buffer += '\n';
+            }
+            size_t column = k % width;
+            if (formats & RESULT_CSV) {
+                format_cell(batch, batch.cells[k], column == 0);
+                if (column + 1 == width) buffer += '\n';
+            }
+            if (formats & RESULT_COLUMNS) {
+                const Cell& cell = batch.cells[k];
+                column_data[column].push_back(cell.kind == REAL || cell.kind == INTEGER ? cell.value : NAN);
+            }
+            if (buffer.size() >= BUFFER_BYTES) drain_buffer();
+        }
+        for (; line < batch.lines.size(); line++) {
+            buffer += batch.lines[line].second;
+            buffer += '\n';
+        }
+        drain_buffer();
+    }
+
+    void drain_buffer() {
+        if (csv && !buffer.empty() && std::fwrite(buffer.data(), 1, buffer.size(), csv) != buffer.size()) {
+            write_failed = true;
+        }
+        buffer.clear();
+    }
+
+    void worker_loop() {
+        while (true) {
+            Batch batch;
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                ready.wait(lock, [&] { return stopping || !queue.empty(); });
+                if (queue.empty()) return;
+                batch = std::move(queue.front());
+                queue.pop_front();
+            }
+            write_batch(batch);
+        }
+    }
+
+    void hand_off() {
+        if (current.cells.empty() && current.lines.empty()) return;
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            queue.push_back(std::move(current));
+        }
+        ready.notify_one();
+        current = Batch();
+        current.cells.reserve(BATCH_CELLS);
+    }
+
+    void add(double value, CellKind kind) {
+        current.cells.push_back({value, kind});
+        if (++row_cells > columns.size()) {
+            std::cerr << "Error: " << path << ": row has more than " << columns.size()
+                      << " values" << std::endl;
+            failed = true;
+        }
+    }
+
+    void write_column_dump() {
+        std::string cols_path = path;
+        if (cols_path.size() >= 4 && cols_path.compare(cols_path.size() - 4, 4, ".csv") == 0) {
+            cols_path.resize(cols_path.size() - 4);
+        }
+        cols_path += ".cols";
+        FILE* file = std::fopen(cols_path.c_str(), "wb");
+        if (!file) {
+            failed = true;
+            return;
+        }
+        uint32_t version = 1, count = columns.size();
+        uint64_t num_rows = rows;
+        size_t header = 8 + 4 + 4 + 8;
+        std::fwrite("RESCOLS1", 1, 8, file);
+        std::fwrite(&version, sizeof(version), 1, file);
+        std::fwrite(&count, sizeof(count), 1, file);
+        std::fwrite(&num_rows, sizeof(num_rows), 1, file);
+        for (const std::string& name : columns) {
+            uint32_t length = name.size();
+            std::fwrite(&length, sizeof(length), 1, file);
+            std::fwrite(name.data(), 1, length, file);
+            header += 4 + length;
+        }
+        static const char zeros[8] = {0};
+        std::fwrite(zeros, 1, (8 - header % 8) % 8, file);
+        for (const std::vector<double>& column : column_data) {
+            if (std::fwrite(column.data(), sizeof(double), num_rows, file) != num_rows) failed = true;
+        }
+        if (std::fclose(file) != 0) failed = true;
+    }
+
+public:
+    // Empty columns are not allowed; header = false omits the CSV header line
+    ResultWriter(const std::string& path, const std::vector<std::string>& columns,
+                 int formats = RESULT_CSV, bool header = true)
+        : path(path), columns(columns), formats(formats), csv(nullptr), failed(false),
+          closed(false), row_cells(0), rows(0), stopping(false), write_failed(false) {
+        if (formats & RESULT_CSV) {
+            csv = std::fopen(path.c_str(), "w");
+            if (!csv) {
+                std::cerr << "Error: cannot open " << path << " for writing" << std::endl;
+                failed = true;
+            }
+        }
+        if (formats & RESULT_COLUMNS) column_data.resize(columns.size());
+        if (header && csv) {
+            std::string line;
+            for (size_t c = 0; c < columns.size(); c++) {
+                if (c > 0) line += ',';
+                line += columns[c];
+            }
+            current.lines.push_back({0, line});
+        }
+        current.cells.reserve(BATCH_CELLS);
+        worker = std::thread(&ResultWriter::worker_loop, this);
+    }
+
+    ~ResultWriter() { close(); }
+
+    ResultWriter(const ResultWriter&) = delete;
+    ResultWriter& operator=(const ResultWriter&) = delete;
+
+    // Next value of the current row: integers print as integers, floating
+    // point values like ostream's default (%g), strings as they are
+    template <typename T>
+    ResultWriter& operator<<(T value) {
+        static_assert(std::is_arithmetic<T>::value, "ResultWriter cells are numbers or strings");
+        add((double)value, std::is_integral<T>::value ? INTEGER : REAL);
+        return *this;
+    }
+
+    ResultWriter& operator<<(const std::string& value) {
+        add(current.texts.size(), TEXT);
+        current.texts.push_back(value);
+        return *this;
+    }
+
+    ResultWriter& operator<<(const char* value) {
+        return *this << std::string(value);
+    }
+
+    // `count` empty cells (a column that does not apply to this row)
+    void skip(int count = 1) {
+        for (int k = 0; k < count; k++) add(0.0, EMPTY);
+    }
+
+    // Finish the current row (it must have one value per column)
+    void end_row() {
+        if (row_cells != columns.size()) {
+            std::cerr << "Error: " << path << ": row has " << row_cells << " values, expected "
+                      << columns.size() << std::endl;
+            failed = true;
+            current.cells.resize(current.cells.size() - row_cells);
+        } else {
+            rows++;
+        }
+        row_cells = 0;
+        if (current.cells.size() >= BATCH_CELLS) hand_off();
+    }
+
+    // A text line in the CSV output before the next row (not in the dump)
+    void text(const std::string& line) {
+        current.lines.push_back({current.cells.size() - row_cells, line});
+    }
+
+    // Wait for the worker, close the files; false if anything failed
+    bool close() {
+        if (closed) return !failed;
+        closed = true;
+        if (row_cells > 0) end_row();
+        hand_off();
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            stopping = true;
+        }
+        ready.notify_one();
+        worker.join();
+        failed = failed || write_failed;
+        if (csv && std::fclose(csv) != 0) failed = true;
+        csv = nullptr;
+        if (formats & RESULT_COLUMNS) write_column_dump();
+        return !failed;
+    }
+
+    long long row_count() const { return rows; }
+};
+
+#endif
@@ -0,0 +1,102 @@
+/*
+ * Fixed-size worker team shared by both problems
+ * ==============================================
+ *
+ * run() executes one task on every worker (the calling thread is worker 0)
+ * and returns when all of them have finished. The workers stay alive
+ * between calls, so level-synchronous algorithms can call run() once per
+ * level without paying for thread creation.
+ *
+ * Compile with -pthread on Linux.
+ */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;
+    std::mutex mtx;
+    std::condition_variable start_cv, done_cv;
+    const std::function<void(int)>* task;
+    long long generation;
+    int running;
+    bool stopping;
+
+    void worker_loop(int id) {
+        long long seen = 0;
+        while (true) {
+            const std::function<void(int)>* current;
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                start_cv.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping) return;
+                seen = generation;
+                current = task;
+            }
+            (*current)(id);
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                if (--running == 0) done_cv.notify_one();
+            }
+        }
+    }
+
+public:
+    explicit ThreadPool(int num_threads)
+        : task(nullptr), generation(0), running(0), stopping(false) {
+        for (int id = 1; id < num_threads; id++) {
+            workers.emplace_back(&ThreadPool::worker_loop, this, id);
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            stopping = true;
+        }
+        start_cv.notify_all();
+        for (auto& w : workers) w.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int size() const {
+        return (int)workers.size() + 1;
+    }
+
+    // Run task(worker_id) for worker_id = 0..size()-1 and wait for all
+    void run(const std::function<void(int)>& fn) {
+        if (workers.empty()) {
+            fn(0);
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            task = &fn;
+            running = (int)workers.size();
+            generation++;
+        }
+        start_cv.notify_all();
+        fn(0);
+        std::unique_lock<std::mutex> lock(mtx);
+        done_cv.wait(lock, [&] { return running == 0; });
+    }
+
+    // Half-open range [begin, end) of worker `id` when n items are split evenly
+    static std::pair<int, int> chunk(int n, int parts, int id) {
+        long long begin = (long long)n * id / parts;
+        long long end = (long long)n * (id + 1) / parts;
+        return {(int)begin, (int)end};
+    }
+};
+
+#endif